@@ -1,5 +1,8 @@
 
 from m5.objects import *
+from m5.defines import buildEnv
+from m5.util import fatal
+from m5.util.convert import toMemorySize
 
 def initializeADFA(options):
     adfa = AbstractDataFlowAccelerator()
@@ -32,9 +35,30 @@ def initializeStreamEngine(options):
         options.gem_forge_stream_engine_total_run_ahead_length
     se.totalRunAheadBytes = \
         options.gem_forge_stream_engine_total_run_ahead_bytes
+    if options.gem_forge_stream_engine_l1d_stream_ways > 0:
+        # Only MESI_Three_Level_Stream reserves the L1D ways.
+        if not options.ruby or \
+                buildEnv['PROTOCOL'] != 'MESI_Three_Level_Stream':
+            fatal('L1D stream ways are only supported by '
+                  'MESI_Three_Level_Stream.')
+        # Stream data is buffered in the reserved L1D ways instead.
+        se.totalRunAheadBytes = \
+            toMemorySize(options.l1d_size) * \
+            options.gem_forge_stream_engine_l1d_stream_ways // \
+            options.l1d_assoc
     se.maxNumElementsPrefetchForAtomic = \
         options.gem_forge_stream_engine_max_num_elements_prefetch_for_atomic
     se.throttling = options.gem_forge_stream_engine_throttling
+    se.throttlingMaxSizeForOuterLoopStream = \
+        options.gem_forge_stream_engine_throttling_max_size_for_outer_loop_stream
+    se.throttlingUtilityEpochCycles = \
+        options.gem_forge_stream_engine_throttling_utility_epoch_cycles
+    se.throttlingUtilityIdleCycles = \
+        options.gem_forge_stream_engine_throttling_utility_idle_cycles
+    se.throttlingUtilityMinEpochSamples = \
+        options.gem_forge_stream_engine_throttling_utility_min_epoch_samples
+    se.throttlingUtilityIdleRatio = \
+        options.gem_forge_stream_engine_throttling_utility_idle_ratio
     se.streamEngineEnableLSQ = options.gem_forge_stream_engine_enable_lsq
     se.streamEngineForceNoFlushPEB = options.gem_forge_stream_engine_force_no_flush_peb
     se.streamEngineEnableCoalesce = options.gem_forge_stream_engine_enable_coalesce
@@ -48,6 +72,19 @@ def initializeStreamEngine(options):
         options.gem_forge_stream_engine_enable_float_pseudo
     se.streamEngineEnableFloatCancel = \
         options.gem_forge_stream_engine_enable_float_cancel
+    if options.gem_forge_stream_engine_float_policy == 'adaptive':
+        # Adaptive policy sinks streams through float cancel.
+        se.streamEngineEnableFloatCancel = True
+    se.streamEngineSinkHitRate = \
+        options.gem_forge_stream_engine_sink_hit_rate
+    se.streamEngineSinkPartialHitRate = \
+        options.gem_forge_stream_engine_sink_partial_hit_rate
+    se.streamEngineSinkLateRatio = \
+        options.gem_forge_stream_engine_sink_late_ratio
+    se.streamEngineSinkAvgHops = \
+        options.gem_forge_stream_engine_sink_avg_hops
+    se.streamEngineSinkMinFeedbackElements = \
+        options.gem_forge_stream_engine_sink_min_feedback_elements
     if options.gem_forge_stream_engine_enable_float_indirect:
         assert(options.gem_forge_stream_engine_enable_float)
     if options.gem_forge_stream_engine_enable_float_pseudo:
@@ -78,6 +115,12 @@ def initializeStreamEngine(options):
         options.gem_forge_enable_stream_range_sync
     se.enableFloatIndirectReduction =\
         options.gem_forge_enable_stream_float_indirect_reduction
+    se.enableFloatParallelReduction =\
+        options.gem_forge_enable_stream_float_parallel_reduction
+    se.enableFloatMultiLevelIndirect =\
+        options.gem_forge_enable_stream_float_multi_level_indirect
+    se.enableFloatPredicatedReduction =\
+        options.gem_forge_enable_stream_float_predicated_reduction
     se.enableFloatTwoLevelIndirectStoreCompute =\
         options.gem_forge_enable_stream_float_two_level_indirect_store_compute
     se.enableFineGrainedNearDataComputing =\
@@ -86,6 +129,7 @@ def initializeStreamEngine(options):
     se.enableFloatMem =\
         options.gem_forge_stream_engine_enable_float_mem
     se.floatLevelPolicy = options.gem_forge_stream_engine_float_level_policy
+    se.enableEventTrace = options.gem_forge_stream_engine_enable_event_trace
 
     return se
 
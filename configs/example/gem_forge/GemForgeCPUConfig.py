@@ -62,11 +62,26 @@ def get_processes(options):
             process.markHistory = history
         process.markSwitchcpu = options.gem_forge_work_mark_switch_cpu
         process.markEnd = options.gem_forge_work_mark_end
+        process.markSamplePeriod = options.gem_forge_work_mark_sample_period
+        process.markSampleWarmup = options.gem_forge_work_mark_sample_warmup
+        process.markSampleDetail = options.gem_forge_work_mark_sample_detail
         process.enableStreamNUCA = options.gem_forge_enable_stream_nuca
         process.streamNUCAIndPageRemapPolicy = \
             options.gem_forge_stream_nuca_ind_page_remap_policy
         process.streamNUCAIndPageRemapThreshold = \
             options.gem_forge_stream_nuca_ind_page_remap_threshold
+        process.streamNUCARemapThreads = \
+            options.gem_forge_stream_nuca_remap_threads
+        process.streamNUCAOnlineMigrate = \
+            options.gem_forge_stream_nuca_online_migrate
+        process.streamNUCAOnlineMigrateInterval = \
+            options.gem_forge_stream_nuca_online_migrate_interval
+        process.streamNUCAOnlineMigrateMaxPages = \
+            options.gem_forge_stream_nuca_online_migrate_max_pages
+        process.streamNUCAOnlineMigrateCopyLatency = \
+            options.gem_forge_stream_nuca_online_migrate_copy_latency
+        process.streamNUCASetPolicy = \
+            options.gem_forge_stream_nuca_set_policy
 
         multiprocesses.append(process)
         idx += 1
@@ -9,6 +9,7 @@ def initializeO3CPU(options, o3cpu):
     o3cpu.issueWidth = options.llvm_issue_width
     o3cpu.wbWidth = options.llvm_issue_width
     o3cpu.commitWidth = options.llvm_issue_width
+    o3cpu.gemForgeWakeupLatency = options.gem_forge_o3_wakeup_latency
     if options.branch_predictor == '2bit':
         o3cpu.branchPred = LocalBP(
             numThreads=options.gem_forge_hardware_contexts_per_core)
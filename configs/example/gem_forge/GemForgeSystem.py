@@ -1,14 +1,148 @@
 import m5
+import os
+from m5.util import addToPath, fatal
+addToPath('../../../util/stats')
+
+def get_stats_file():
+    # The stats file can be an url, e.g. text://stats.txt?desc=False.
+    fn = m5.options.stats_file
+    if '://' in fn:
+        fn = fn.split('://', 1)[1]
+    fn = fn.split('?', 1)[0]
+    return os.path.join(m5.options.outdir, fn)
+
+def get_stats_format():
+    fn = m5.options.stats_file
+    if '://' in fn:
+        return fn.split('://', 1)[0]
+    return 'text'
+
+def parse_binary_stats_dumps(fn):
+    from binary_stats import BinaryStats
+    stats = BinaryStats(fn)
+    return [stats.row(i) for i in range(len(stats))]
+
+def parse_stats_dumps(fn):
+    stats_format = get_stats_format()
+    if stats_format == 'bin':
+        return parse_binary_stats_dumps(fn)
+    if stats_format != 'text':
+        fatal('Cannot aggregate samples from {f} stats.'.format(
+            f=stats_format))
+    dumps = list()
+    with open(fn) as f:
+        for line in f:
+            if line.startswith('---------- Begin Simulation Statistics'):
+                dumps.append(dict())
+                continue
+            if not dumps or line.startswith('----------'):
+                continue
+            fields = line.split()
+            if len(fields) < 2:
+                continue
+            try:
+                dumps[-1][fields[0]] = float(fields[1])
+            except ValueError:
+                continue
+    return dumps
+
+def aggregate_sampled_stats(options, system, num_samples):
+    """
+    Systematic sampling: every sample represents the same number of marks,
+    so the whole run is estimated by scaling the sum of the samples by
+    total marks / measured marks.
+    """
+    if num_samples == 0:
+        print('--- No complete sample to aggregate.')
+        return
+    total_marks = len(system.cpu[0].workload[0].markHistory)
+    if options.gem_forge_work_mark_end != -1:
+        total_marks = min(total_marks, options.gem_forge_work_mark_end)
+    measured_marks = num_samples * options.gem_forge_work_mark_sample_detail
+    weight = float(total_marks) / float(measured_marks)
+    # Our dumps are the last ones.
+    dumps = parse_stats_dumps(get_stats_file())[-num_samples:]
+    names = list()
+    seen = set()
+    for dump in dumps:
+        for name in dump:
+            if name not in seen:
+                seen.add(name)
+                names.append(name)
+    fn = os.path.join(m5.options.outdir, 'sampled_stats.txt')
+    with open(fn, 'w') as f:
+        f.write('# Samples {n} MeasuredMarks {m} TotalMarks {t} Weight {w}\n'.format(
+            n=num_samples, m=measured_marks, t=total_marks, w=weight))
+        f.write('# Name EstimatedTotal MeanPerSample\n')
+        for name in names:
+            total = sum(dump.get(name, 0.0) for dump in dumps)
+            f.write('{name} {est} {mean}\n'.format(
+                name=name, est=total * weight, mean=total / num_samples))
+    print('--- Aggregated {n} samples into {f}'.format(n=num_samples, f=fn))
+
+def run_sampled(options, system, future_cpus, max_tick):
+    """
+    Fast forward with the initial cpus, and switch to the future cpus for
+    the warm up and measured marks of each sample. Each sample is dumped
+    and aggregated at the end.
+    Samples only follow the work mark history of cpu[0]'s process, so
+    multi-process runs are not supported.
+    """
+    assert(future_cpus)
+    assert(options.gem_forge_work_mark_history)
+    if len(options.cmd.split(';')) > 1:
+        fatal('Work mark sampling only supports a single process.')
+    fast_cpus = list(system.cpu)
+    to_detail = [(fast_cpus[i], future_cpus[i]) for i in range(len(fast_cpus))]
+    to_fast = [(future_cpus[i], fast_cpus[i]) for i in range(len(fast_cpus))]
+    in_detail = False
+    num_samples = 0
+    while True:
+        exit_event = m5.simulate(max_tick - m5.curTick())
+        exit_cause = exit_event.getCause()
+        print('**** Exit @ tick {t} as {s} ****'.format(
+            t=m5.curTick(), s=exit_cause))
+        if exit_cause == 'marksamplestart':
+            assert(not in_detail)
+            print('--- Sample {i} starts at work mark {m}'.format(
+                i=num_samples, m=exit_event.getCode()))
+            m5.switchCpus(system, to_detail)
+            in_detail = True
+            m5.stats.reset()
+        elif exit_cause == 'marksampledetail':
+            assert(in_detail)
+            m5.stats.reset()
+        elif exit_cause == 'marksampleend':
+            assert(in_detail)
+            m5.stats.dump()
+            num_samples += 1
+            m5.switchCpus(system, to_fast)
+            in_detail = False
+        elif exit_cause == 'switchcpu':
+            print('Ignore switchcpu pseudo as we are sampling work marks.')
+        else:
+            # Mark end or the program exits.
+            break
+    if exit_cause != 'markend' and exit_event.getCode() != 0:
+        print('Simulated exit code ({s})'.format(
+            s=exit_event.getCode()))
+    aggregate_sampled_stats(options, system, num_samples)
 
 def run(options, root, system, future_cpus):
     checkpoint_dir = None
     # We only allow some number of maximum instructions in real simulation.
-    if future_cpus:
+    # Sampled simulation switches back and forth, so no such limit.
+    if future_cpus and options.gem_forge_work_mark_sample_period <= 0:
         future_cpus[0].max_insts_any_thread = 2e8
 #        for i in range(len(future_cpus)):
 #            future_cpus[i].max_insts_all_threads = 2e9
     m5.instantiate(checkpoint_dir)
+    if options.gem_forge_stats_dump_period > 0:
+        m5.stats.periodicStatDump(options.gem_forge_stats_dump_period)
     max_tick = options.abs_max_tick if options.abs_max_tick else m5.MaxTick
+    if options.gem_forge_work_mark_sample_period > 0:
+        run_sampled(options, system, future_cpus, max_tick)
+        return
     if future_cpus:
         assert(len(future_cpus) == len(system.cpu))
         # Fast forward simulation.
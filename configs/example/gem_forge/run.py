@@ -56,6 +56,14 @@ parser.add_option("--gem-forge-work-mark-switch-cpu", action="store", type="int"
                   help="""switch cpu at this work mark (overrides m5_switch_cpu)""")
 parser.add_option("--gem-forge-work-mark-end", action="store", type="int", default=-1,
                   help="""stop at this work mark (overrides work_item_end)""")
+parser.add_option("--gem-forge-work-mark-sample-period", action="store", type="int", default=-1,
+                  help="""sample detailed simulation every this number of work marks""")
+parser.add_option("--gem-forge-work-mark-sample-warmup", action="store", type="int", default=0,
+                  help="""detailed warm up work marks before measuring each sample""")
+parser.add_option("--gem-forge-work-mark-sample-detail", action="store", type="int", default=1,
+                  help="""measured work marks in each sample""")
+parser.add_option("--gem-forge-stats-dump-period", action="store", type="int", default=0,
+                  help="""dump stats every this number of ticks, 0 to disable (try with --stats-file bin://stats.bin)""")
 parser.add_option("--gem-forge-num-active-cpus", action="store", type="int",
                   help="""number of active cpus.""", default="1")
 parser.add_option("--gem-forge-enable-func-acc-tick", action="store_true",
@@ -99,6 +107,8 @@ parser.add_option("--llvm-store-queue-size", action="store",
                   type="int", help="""store queue size""", default="32")
 parser.add_option("--llvm-load-queue-size", action="store",
                   type="int", help="""load queue size""", default="32")
+parser.add_option("--gem-forge-o3-wakeup-latency", action="store", type="int",
+                  help="""Cycles to wake up an O3 inst waiting on GemForge""", default="1")
 parser.add_option("--gem-forge-cache-load-ports", action="store", type="int",
                   help="""How many loads can be issued in one cycle""", default="4")
 parser.add_option("--gem-forge-cache-store-ports", action="store", type="int",
@@ -127,13 +137,34 @@ parser.add_option("--gem-forge-stream-engine-total-run-ahead-length",
 parser.add_option("--gem-forge-stream-engine-total-run-ahead-bytes",
                   action="store", type="int",
                   help="""How many bytes can the stream engine run ahead""", default="512")
+parser.add_option("--gem-forge-stream-engine-l1d-stream-ways",
+                  action="store", type="int",
+                  help="""Reserve L1D ways as the stream buffer, which replaces
+                  the run ahead bytes (Ruby MESI_Three_Level_Stream only).""",
+                  default="0")
 parser.add_option("--gem-forge-stream-engine-max-num-elements-prefetch-for-atomic", 
                   action="store", type="int",
                   help="""How many elements to prefech to AtomicStream""", default="1024")
 parser.add_option("--gem-forge-stream-engine-is-oracle", action="store", type="int",
                   help="""whether make the stream engine oracle""", default="0")
 parser.add_option("--gem-forge-stream-engine-throttling", action="store", type="string",
-                  help="""Throttling tenchique used by stream engine.""", default="static")
+                  help="""Throttling tenchique used by stream engine:
+                  static, dynamic, global or utility.""", default="static")
+parser.add_option("--gem-forge-stream-engine-throttling-max-size-for-outer-loop-stream",
+                  type="int", action="store", default="8",
+                  help="Do not throttle outer loop streams beyond this maxSize.")
+parser.add_option("--gem-forge-stream-engine-throttling-utility-epoch-cycles",
+                  type="int", action="store", default="2000",
+                  help="Utility throttling redistributes entries every this cycles.")
+parser.add_option("--gem-forge-stream-engine-throttling-utility-idle-cycles",
+                  type="int", action="store", default="20",
+                  help="Elements ready this cycles before used are idle.")
+parser.add_option("--gem-forge-stream-engine-throttling-utility-min-epoch-samples",
+                  type="int", action="store", default="4",
+                  help="Min sampled elements in an epoch to update the utility.")
+parser.add_option("--gem-forge-stream-engine-throttling-utility-idle-ratio",
+                  type="float", action="store", default="0.5",
+                  help="Ratio of idle elements to drop the utility to 0.")
 parser.add_option("--gem-forge-stream-engine-enable-lsq", action="store_true",
                   help="""Enable stream lsq in the stream engine.""", default=False)
 parser.add_option("--gem-forge-stream-engine-force-no-flush-peb", action="store_true",
@@ -149,8 +180,24 @@ parser.add_option("--gem-forge-stream-engine-placement",
 parser.add_option("--gem-forge-stream-engine-enable-float", action="store_true", default=False,
                   help="Enable stream float in LLC.")
 parser.add_option("--gem-forge-stream-engine-float-policy", type="choice", default="static",
-                  choices=['static', 'manual', 'smart', 'smart-computation'],
+                  choices=['static', 'manual', 'smart', 'smart-computation',
+                           'adaptive'],
                   help="Policy to choose floating stream in LLC.")
+parser.add_option("--gem-forge-stream-engine-sink-hit-rate", type="float",
+                  action="store", default="0.75",
+                  help="Adaptive float sinks if private cache hit rate reaches this.")
+parser.add_option("--gem-forge-stream-engine-sink-partial-hit-rate",
+                  type="float", action="store", default="0.5",
+                  help="Adaptive float sinks late or far streams above this hit rate.")
+parser.add_option("--gem-forge-stream-engine-sink-late-ratio", type="float",
+                  action="store", default="0.5",
+                  help="Ratio of late floated elements to be considered late.")
+parser.add_option("--gem-forge-stream-engine-sink-avg-hops", type="float",
+                  action="store", default="4.0",
+                  help="Average hops from LLC bank to be considered far.")
+parser.add_option("--gem-forge-stream-engine-sink-min-feedback-elements",
+                  type="int", action="store", default="4",
+                  help="Min floated elements before the late ratio is trusted.")
 parser.add_option("--gem-forge-stream-engine-enable-float-indirect", action="store_true",
                   default=False,
                   help="Enable indirect stream float in LLC.")
@@ -255,6 +302,17 @@ parser.add_option("--gem-forge-stream-atomic-lock-type", type="choice", default=
 parser.add_option("--gem-forge-enable-stream-float-indirect-reduction", action="store_true",
                   default="False",
                   help="Enable floating indirect reduction stream.")
+parser.add_option("--gem-forge-enable-stream-float-parallel-reduction",
+                  action="store_true", default="False",
+                  help="Reduce floated direct reduction stream at each LLC "
+                  "bank in parallel and combine along a tree.")
+parser.add_option("--gem-forge-enable-stream-float-multi-level-indirect",
+                  action="store_true", default="False",
+                  help="Enable floating indirect load chains, e.g. A[B[C[i]]].")
+parser.add_option("--gem-forge-enable-stream-float-predicated-reduction",
+                  action="store_true", default="False",
+                  help="Enable floating predicated reduction stream, "
+                  "e.g. filtered scan.")
 parser.add_option("--gem-forge-enable-stream-float-two-level-indirect-store-compute",
                   action="store_true", default="False",
                   help="Enable floating two-level indirect store compute stream.")
@@ -267,6 +325,12 @@ parser.add_option("--gem-forge-stream-engine-llc-neighbor-migration-delay", acti
 parser.add_option("--gem-forge-stream-engine-llc-neighbor-migration-valve-type", type="choice",
                   choices=['none', 'all', 'hard'], default='none',
                   help="Apply valve to all streams.")
+parser.add_option("--gem-forge-stream-engine-llc-region-fetch-lines", action="store",
+                  type="int", default="0",
+                  help="Max lines per stream region fetch from LLC to memory, <= 1 to disable.")
+parser.add_option("--gem-forge-stream-engine-llc-compressor", type="choice",
+                  choices=['none', 'bdi', 'cpack', 'fpcd', 'zero'], default='none',
+                  help="Compressor to size stream data messages sent from LLC.")
 parser.add_option("--gem-forge-stream-engine-enable-fine-grained-near-data-computing",
                   action="store_true", default="False",
                   help="Enable per element computation offloading.")
@@ -279,10 +343,30 @@ parser.add_option("--gem-forge-stream-nuca-ind-page-remap-policy", type="choice"
 parser.add_option("--gem-forge-stream-nuca-ind-page-remap-threshold", type="float",
                   action="store", default="0.0",
                   help="Remap indirect page if we achieve traffic reduction threshold.")
+parser.add_option("--gem-forge-stream-nuca-remap-threads", type="int",
+                  action="store", default="0",
+                  help="Host threads to remap indirect region, 0 for all cores.")
+parser.add_option("--gem-forge-stream-nuca-online-migrate", action="store_true",
+                  default=False,
+                  help="Migrate indirect pages online by sampled LLC stream traffic.")
+parser.add_option("--gem-forge-stream-nuca-online-migrate-interval", type="int",
+                  action="store", default="100000",
+                  help="Sampled indirect accesses between online migration.")
+parser.add_option("--gem-forge-stream-nuca-online-migrate-max-pages", type="int",
+                  action="store", default="64",
+                  help="Max pages migrated online at a time (negative for no limit).")
+parser.add_option("--gem-forge-stream-nuca-online-migrate-copy-latency",
+                  type="string", action="store", default="1ns",
+                  help="Latency to copy one cache line of a migrated page.")
+parser.add_option("--gem-forge-stream-nuca-set-policy", type="choice",
+                  choices=['footprint', 'stagger'], default='footprint',
+                  help="How to assign LLC start set to aligned regions.")
 
 # Stream in Mem Options.
 parser.add_option("--gem-forge-stream-engine-enable-float-mem", action="store_true", default=False,
                   help="Enable stream float in Mem Ctrl.")
+parser.add_option("--gem-forge-stream-engine-enable-event-trace", action="store_true", default=False,
+                  help="Trace stream events to stream_event_trace/events.bin.")
 parser.add_option("--gem-forge-stream-engine-float-level-policy", type="choice", default="static",
                   choices=['static', 'manual', 'manual2', 'smart'],
                   help="Policy to choose floating level for streams.")
@@ -335,6 +419,12 @@ if args:
 if options.cpu_type == "LLVMTraceCPU":
     fatal("The host CPU should be a normal CPU other than LLVMTraceCPU\n")
 
+if options.gem_forge_stream_engine_llc_compressor != 'none':
+    if not options.ruby or \
+            buildEnv['PROTOCOL'] != 'MESI_Three_Level_Stream':
+        fatal("Stream compressor is only supported by "
+              "MESI_Three_Level_Stream.\n")
+
 # Create the cpus.
 (initial_cpus, future_cpus, test_mem_mode) = \
      GemForgeCPUConfig.initializeCPUs(options)
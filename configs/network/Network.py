@@ -61,6 +61,26 @@ def define_options(parser):
     parser.add_option("--vcs-per-vnet", action="store", type="int", default=4,
                       help="""number of virtual channels per virtual network
                             inside garnet network.""")
+    parser.add_option("--vnet-link-width-bits", action="store", type="string",
+                      default="",
+                      help="""comma separated width in bits per virtual
+                            network, --link-width-bits if not set.""")
+    parser.add_option("--vnet-vcs", action="store", type="string",
+                      default="",
+                      help="""comma separated virtual channels per virtual
+                            network, at most --vcs-per-vnet.""")
+    parser.add_option("--bulk-data-vnet", action="store", type="int",
+                      default=-1,
+                      help="""virtual network with its own flit width on
+                            the shared links, e.g. 1 for the response vnet
+                            of stream data.""")
+    parser.add_option("--bulk-data-link-width-bits", action="store",
+                      type="int", default=512,
+                      help="width in bits of the bulk data virtual network.")
+    parser.add_option("--bulk-data-vcs", action="store", type="int",
+                      default=0,
+                      help="""virtual channels of the bulk data virtual
+                            network, --vcs-per-vnet if 0.""")
     parser.add_option("--routing-algorithm", action="store", type="int",
                       default=0,
                       help="""routing algorithm in network.
@@ -79,6 +99,11 @@ def define_options(parser):
     parser.add_option("--garnet-enable-multicast", action="store_true",
                       default=False,
                       help="""enable multicast""")
+    parser.add_option("--garnet-multicast-ni-duplicate", action="store_true",
+                      default=False,
+                      help="""replicate multicast packets by re-injecting
+                            them at the branching router's NI instead of
+                            in the router crossbar""")
 
 
 def create_network(options, ruby):
@@ -111,9 +136,19 @@ def init_network(options, network, InterfaceClass):
         network.num_rows = options.mesh_rows
         network.vcs_per_vnet = options.vcs_per_vnet
         network.ni_flit_size = options.link_width_bits / 8
+        if options.vnet_link_width_bits:
+            network.vnet_flit_size = [int(w) / 8 for w in
+                options.vnet_link_width_bits.split(',')]
+        if options.vnet_vcs:
+            network.vnet_vcs = [int(v) for v in options.vnet_vcs.split(',')]
+        network.bulk_data_vnet = options.bulk_data_vnet
+        network.bulk_data_flit_size = options.bulk_data_link_width_bits / 8
+        network.bulk_data_vcs = options.bulk_data_vcs
         network.routing_algorithm = options.routing_algorithm
         network.garnet_deadlock_threshold = options.garnet_deadlock_threshold
         network.enable_multicast = options.garnet_enable_multicast
+        network.multicast_in_router = \
+            not options.garnet_multicast_ni_duplicate
 
     if options.network == "simple":
         network.setup_buffers()
@@ -32,6 +32,7 @@
 import math
 import m5
 from m5.objects import *
+from m5.params import NULL
 from m5.defines import buildEnv
 from .Ruby import create_topology, create_directories
 from .Ruby import send_evicts
@@ -53,6 +54,18 @@ def define_options(parser):
     parser.add_option("--l2-transitions-per-cycle", type="int", default=4)
     return
 
+def create_stream_compressor(options):
+    compressor = options.gem_forge_stream_engine_llc_compressor
+    if compressor == 'bdi':
+        return BDI()
+    elif compressor == 'cpack':
+        return CPack()
+    elif compressor == 'fpcd':
+        return FPCD()
+    elif compressor == 'zero':
+        return ZeroCompressor()
+    return NULL
+
 def create_system(options, full_system, system, dma_ports, bootmem,
                   ruby_system):
 
@@ -111,7 +124,8 @@ def create_system(options, full_system, system, dma_ports, bootmem,
             l0d_cache = L0Cache(size=options.l1d_size, assoc=options.l1d_assoc, is_icache=False,
                 start_index_bit=block_size_bits,
                 replacement_policy=LRURP(),
-                dataAccessLatency=options.l1d_lat)
+                dataAccessLatency=options.l1d_lat,
+                num_stream_ways=options.gem_forge_stream_engine_l1d_stream_ways)
 #                replacement_policy=BRRIPRP(),
 #                dataAccessLatency=options.l1d_lat)
 
@@ -388,6 +402,9 @@ def create_system(options, full_system, system, dma_ports, bootmem,
                 neighbor_migration_valve_type=\
                     options.gem_forge_stream_engine_llc_neighbor_migration_valve_type,
                 enable_stream_float_mem=options.gem_forge_stream_engine_enable_float_mem,
+                stream_region_fetch_lines=\
+                    options.gem_forge_stream_engine_llc_region_fetch_lines,
+                stream_compressor=create_stream_compressor(options),
                 )
 
             exec("ruby_system.l2_cntrl%d = l2_cntrl"
@@ -447,6 +464,7 @@ def create_system(options, full_system, system, dma_ports, bootmem,
         dir_cntrl.requestFromDir.master = ruby_system.network.slave
         dir_cntrl.requestToMemory = MessageBuffer()
         dir_cntrl.responseFromMemory = MessageBuffer()
+        dir_cntrl.streamRegionFetchQueue = MessageBuffer()
 
         # ! Sean: StreamAwareCache
         dir_cntrl.streamMigrateFromMem = MessageBuffer()
@@ -234,6 +234,7 @@ def create_system(options, full_system, system, dma_ports, bootmem,
         dir_cntrl.requestFromDir.master = ruby_system.network.slave
         dir_cntrl.requestToMemory = MessageBuffer()
         dir_cntrl.responseFromMemory = MessageBuffer()
+        dir_cntrl.streamRegionFetchQueue = MessageBuffer()
 
         # ! Sean: StreamAwareCache
         dir_cntrl.streamMigrateFromMem = MessageBuffer()
@@ -0,0 +1,8 @@
+#include "sim/eventq.hh"
+
+/**
+ * Test-only definition of the current event queue, for gtests of code that
+ * references curTick() without linking the event queue. The queue is not
+ * set, so such tests must not actually call curTick().
+ */
+__thread EventQueue *_curEventQueue = nullptr;
@@ -0,0 +1,39 @@
+#include "base/host_profile.hh"
+
+namespace HostProfile {
+
+namespace {
+
+std::vector<Counter *> &
+counterList()
+{
+    // Construct on first use, as counters are static objects in other
+    // translation units.
+    static std::vector<Counter *> list;
+    return list;
+}
+
+} // namespace
+
+thread_local ScopedTimer *ScopedTimer::current = nullptr;
+
+Counter::Counter(const char *_name)
+    : name(_name)
+{
+    counterList().push_back(this);
+}
+
+const std::vector<Counter *> &
+counters()
+{
+    return counterList();
+}
+
+void
+resetCounters()
+{
+    for (auto counter : counterList())
+        counter->reset();
+}
+
+} // namespace HostProfile
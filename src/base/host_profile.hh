@@ -0,0 +1,122 @@
+#ifndef __BASE_HOST_PROFILE_HH__
+#define __BASE_HOST_PROFILE_HH__
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "config/host_profile.hh"
+
+/**
+ * Built-in host side profiling of simulator hot paths, enabled by building
+ * with HOST_PROFILE=True. Each profiled function declares a counter at
+ * namespace scope and opens a scoped timer:
+ *
+ *   HOST_PROFILE_COUNTER(fooTick, "foo.tick");
+ *   void Foo::tick() { HOST_PROFILE_SCOPE(fooTick); ... }
+ *
+ * A counter records the number of calls, the inclusive host cycles and
+ * the self cycles, i.e. excluding nested profiled scopes, so that nested
+ * counters (e.g. everything under EventQueue::serviceOne) can still be
+ * attributed to subsystems. The counters are dumped with the normal stats
+ * as host_profile.<name>.{calls,cycles,self_cycles} and reset with them.
+ *
+ * Without HOST_PROFILE the macros expand to nothing.
+ */
+namespace HostProfile {
+
+/**
+ * Host timestamp. Use the TSC on x86 and a steady clock (in ns) otherwise.
+ */
+inline uint64_t
+now()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/**
+ * The counters are not atomic. With multiple event queue threads they
+ * are approximate, like the other host stats.
+ */
+class Counter
+{
+  public:
+    const char *const name;
+    uint64_t calls = 0;
+    uint64_t cycles = 0;
+    uint64_t selfCycles = 0;
+
+    explicit Counter(const char *_name);
+
+    Counter(const Counter &other) = delete;
+    Counter &operator=(const Counter &other) = delete;
+
+    void reset() { calls = cycles = selfCycles = 0; }
+};
+
+/**
+ * All counters in construction order. Counters are constructed during
+ * static initialization, so this is complete before stats are registered.
+ */
+const std::vector<Counter *> &counters();
+void resetCounters();
+
+class ScopedTimer
+{
+  public:
+    explicit ScopedTimer(Counter &_counter)
+        : counter(_counter), parent(current), start(now())
+    {
+        current = this;
+    }
+
+    ~ScopedTimer()
+    {
+        uint64_t elapsed = now() - start;
+        counter.calls++;
+        counter.cycles += elapsed;
+        counter.selfCycles += elapsed - childCycles;
+        if (parent)
+            parent->childCycles += elapsed;
+        current = parent;
+    }
+
+    ScopedTimer(const ScopedTimer &other) = delete;
+    ScopedTimer &operator=(const ScopedTimer &other) = delete;
+
+  private:
+    Counter &counter;
+    ScopedTimer *const parent;
+    const uint64_t start;
+    uint64_t childCycles = 0;
+
+    /** Innermost open timer of this host thread. */
+    static thread_local ScopedTimer *current;
+};
+
+} // namespace HostProfile
+
+#if HOST_PROFILE
+
+#define HOST_PROFILE_COUNTER(var, name)                                   \
+    static ::HostProfile::Counter var(name)
+#define HOST_PROFILE_SCOPE(var)                                           \
+    ::HostProfile::ScopedTimer var##ScopedTimer(var)
+
+#else
+
+#define HOST_PROFILE_COUNTER(var, name)
+#define HOST_PROFILE_SCOPE(var)
+
+#endif // HOST_PROFILE
+
+#endif // __BASE_HOST_PROFILE_HH__
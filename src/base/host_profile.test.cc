@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "base/host_profile.hh"
+
+namespace {
+
+HostProfile::Counter outerCounter("test.outer");
+HostProfile::Counter innerCounter("test.inner");
+
+void
+inner()
+{
+    HostProfile::ScopedTimer timer(innerCounter);
+    volatile int sum = 0;
+    for (int i = 0; i < 1000; ++i)
+        sum = sum + i;
+}
+
+} // namespace
+
+TEST(HostProfileTest, Registered)
+{
+    const auto &counters = HostProfile::counters();
+    EXPECT_NE(std::find(counters.begin(), counters.end(), &outerCounter),
+              counters.end());
+    EXPECT_NE(std::find(counters.begin(), counters.end(), &innerCounter),
+              counters.end());
+}
+
+TEST(HostProfileTest, NestedSelfCycles)
+{
+    HostProfile::resetCounters();
+    {
+        HostProfile::ScopedTimer timer(outerCounter);
+        inner();
+        inner();
+    }
+    EXPECT_EQ(1, outerCounter.calls);
+    EXPECT_EQ(2, innerCounter.calls);
+    // Inner has no nested scope.
+    EXPECT_EQ(innerCounter.cycles, innerCounter.selfCycles);
+    // Outer excludes the inner cycles from self cycles.
+    EXPECT_GE(outerCounter.cycles, innerCounter.cycles);
+    EXPECT_EQ(outerCounter.cycles - innerCounter.cycles,
+              outerCounter.selfCycles);
+
+    HostProfile::resetCounters();
+    EXPECT_EQ(0, outerCounter.calls);
+    EXPECT_EQ(0, innerCounter.cycles);
+}
@@ -0,0 +1,347 @@
+#include "base/stats/binary.hh"
+
+#include <zlib.h>
+
+#include <cstring>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/stats/info.hh"
+#include "sim/core.hh"
+
+namespace {
+
+void
+putBytes(std::vector<uint8_t> &buffer, uint64_t value, int bytes)
+{
+    // Always little endian.
+    for (int i = 0; i < bytes; ++i) {
+        buffer.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+uint64_t
+toBits(Stats::Result value)
+{
+    static_assert(sizeof(Stats::Result) == sizeof(uint64_t),
+                  "Result should be double.");
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+} // namespace
+
+namespace Stats {
+
+constexpr uint32_t Binary::Version;
+constexpr uint8_t Binary::RecordSchema;
+constexpr uint8_t Binary::RecordRow;
+constexpr uint8_t Binary::RowDelta;
+constexpr uint8_t Binary::RowCompressed;
+
+Binary::Binary(std::ostream &_stream, bool delta, bool compress,
+               unsigned _keyframe, bool formulas)
+    : stream(_stream), enableDelta(delta), enableCompress(compress),
+      keyframe(_keyframe > 0 ? _keyframe : 1), enableFormula(formulas)
+{
+    if (!valid())
+        fatal("Unable to open binary statistics file for writing\n");
+
+    // File header: magic, version, flags.
+    buffer.clear();
+    for (auto c : std::string("GFSTATS\0", 8)) {
+        buffer.push_back(static_cast<uint8_t>(c));
+    }
+    putBytes(buffer, Version, 4);
+    putBytes(buffer, (enableDelta ? RowDelta : 0) |
+                     (enableCompress ? RowCompressed : 0), 4);
+    stream.write(reinterpret_cast<const char *>(buffer.data()),
+                 buffer.size());
+}
+
+bool
+Binary::valid() const
+{
+    return stream.good();
+}
+
+void
+Binary::begin()
+{
+    row.clear();
+}
+
+void
+Binary::end()
+{
+    if (buildSchema) {
+        writeSchema();
+        buildSchema = false;
+    } else if (row.size() != prevRow.size()) {
+        fatal("Binary stats columns changed from %d to %d at dump %d.\n",
+              prevRow.size(), row.size(), dumpCount);
+    }
+    writeRow();
+    stream.flush();
+    dumpCount++;
+}
+
+void
+Binary::beginGroup(const char *name)
+{
+    if (path.empty()) {
+        path.push(name);
+    } else {
+        path.push(csprintf("%s.%s", path.top(), name));
+    }
+}
+
+void
+Binary::endGroup()
+{
+    assert(!path.empty());
+    path.pop();
+}
+
+bool
+Binary::noOutput(const Info &info) const
+{
+    // Unlike text, ignore the prereq to keep the columns fixed.
+    return !info.flags.isSet(display);
+}
+
+std::string
+Binary::statName(const std::string &name) const
+{
+    if (path.empty())
+        return name;
+    else
+        return csprintf("%s.%s", path.top(), name);
+}
+
+void
+Binary::append(const std::string &name, Result value)
+{
+    if (buildSchema)
+        names.push_back(name);
+    row.push_back(toBits(value));
+}
+
+void
+Binary::append(const std::string &name, const std::string &subname,
+               Result value)
+{
+    if (buildSchema)
+        names.push_back(name + "::" + subname);
+    row.push_back(toBits(value));
+}
+
+void
+Binary::appendDist(const std::string &name, const DistData &data)
+{
+    append(name, "samples", data.samples);
+    append(name, "min_value", data.min_val);
+    append(name, "max_value", data.max_val);
+    append(name, "sum", data.sum);
+    append(name, "squares", data.squares);
+    if (data.type == Deviation)
+        return;
+    append(name, "bucket_size", data.bucket_size);
+    append(name, "underflows", data.underflow);
+    append(name, "overflows", data.overflow);
+    for (size_t i = 0; i < data.cvec.size(); ++i) {
+        append(name, buildSchema ? csprintf("bucket%d", i) : "",
+               data.cvec[i]);
+    }
+}
+
+void
+Binary::appendVector(const std::string &name, const VectorInfo &info)
+{
+    const VResult &vec = info.result();
+    for (size_t i = 0; i < vec.size(); ++i) {
+        std::string subname;
+        if (buildSchema) {
+            subname = (i < info.subnames.size() && !info.subnames[i].empty())
+                          ? info.subnames[i]
+                          : csprintf("%d", i);
+        }
+        append(name, subname, vec[i]);
+    }
+}
+
+void
+Binary::visit(const ScalarInfo &info)
+{
+    if (noOutput(info))
+        return;
+    append(buildSchema ? statName(info.name) : "", info.result());
+}
+
+void
+Binary::visit(const VectorInfo &info)
+{
+    if (noOutput(info))
+        return;
+    appendVector(buildSchema ? statName(info.name) : "", info);
+}
+
+void
+Binary::visit(const DistInfo &info)
+{
+    if (noOutput(info))
+        return;
+    appendDist(buildSchema ? statName(info.name) : "", info.data);
+}
+
+void
+Binary::visit(const VectorDistInfo &info)
+{
+    if (noOutput(info))
+        return;
+    for (size_t i = 0; i < info.data.size(); ++i) {
+        std::string name;
+        if (buildSchema) {
+            name = statName(info.name) + "::" +
+                   ((i < info.subnames.size() && !info.subnames[i].empty())
+                        ? info.subnames[i]
+                        : csprintf("%d", i));
+        }
+        appendDist(name, info.data[i]);
+    }
+}
+
+void
+Binary::visit(const Vector2dInfo &info)
+{
+    if (noOutput(info))
+        return;
+    for (size_t x = 0; x < info.x; ++x) {
+        for (size_t y = 0; y < info.y; ++y) {
+            std::string name;
+            if (buildSchema) {
+                name = csprintf(
+                    "%s::%s::%s", statName(info.name),
+                    (x < info.subnames.size() && !info.subnames[x].empty())
+                        ? info.subnames[x]
+                        : csprintf("%d", x),
+                    (y < info.y_subnames.size() &&
+                     !info.y_subnames[y].empty())
+                        ? info.y_subnames[y]
+                        : csprintf("%d", y));
+            }
+            append(name, info.cvec[x * info.y + y]);
+        }
+    }
+}
+
+void
+Binary::visit(const FormulaInfo &info)
+{
+    if (!enableFormula || noOutput(info))
+        return;
+    if (info.size() == 1) {
+        append(buildSchema ? statName(info.name) : "", info.total());
+    } else {
+        appendVector(buildSchema ? statName(info.name) : "", info);
+    }
+}
+
+void
+Binary::visit(const SparseHistInfo &info)
+{
+    warn_once("Binary stat files don't support sparse histograms.\n");
+}
+
+void
+Binary::writeSchema()
+{
+    buffer.clear();
+    buffer.push_back(RecordSchema);
+    putBytes(buffer, names.size(), 4);
+    for (const auto &name : names) {
+        assert(name.size() <= UINT16_MAX);
+        putBytes(buffer, name.size(), 2);
+        buffer.insert(buffer.end(), name.begin(), name.end());
+    }
+    stream.write(reinterpret_cast<const char *>(buffer.data()),
+                 buffer.size());
+    // The names are no longer needed.
+    names.clear();
+    names.shrink_to_fit();
+}
+
+void
+Binary::writeRow()
+{
+    uint8_t flags = 0;
+    bool delta = enableDelta && (dumpCount % keyframe) != 0;
+    if (delta) {
+        flags |= RowDelta;
+        for (size_t i = 0; i < row.size(); ++i) {
+            prevRow[i] ^= row[i];
+        }
+        // Swap so that row holds the delta and prevRow the new values.
+        row.swap(prevRow);
+    }
+
+    // Serialize the values in little endian.
+    buffer.clear();
+    buffer.reserve(row.size() * sizeof(uint64_t));
+    for (auto value : row) {
+        putBytes(buffer, value, sizeof(uint64_t));
+    }
+    const std::vector<uint8_t> *payload = &buffer;
+    if (enableCompress && !buffer.empty()) {
+        uLongf compressedBytes = compressBound(buffer.size());
+        compressed.resize(compressedBytes);
+        if (compress2(compressed.data(), &compressedBytes, buffer.data(),
+                      buffer.size(), Z_BEST_SPEED) != Z_OK) {
+            fatal("Failed to compress binary stats at dump %d.\n",
+                  dumpCount);
+        }
+        compressed.resize(compressedBytes);
+        flags |= RowCompressed;
+        payload = &compressed;
+    }
+
+    std::vector<uint8_t> header;
+    header.push_back(RecordRow);
+    header.push_back(flags);
+    putBytes(header, dumpTick(), 8);
+    putBytes(header, buffer.size(), 4);
+    putBytes(header, payload->size(), 4);
+    stream.write(reinterpret_cast<const char *>(header.data()),
+                 header.size());
+    stream.write(reinterpret_cast<const char *>(payload->data()),
+                 payload->size());
+
+    // Remember the values for the next delta.
+    if (!delta) {
+        prevRow.swap(row);
+    }
+}
+
+Tick
+Binary::dumpTick() const
+{
+    return curTick();
+}
+
+Output *
+initBinary(const std::string &filename, bool delta, bool compress,
+           unsigned keyframe, bool formulas)
+{
+    static Binary *binary = nullptr;
+
+    if (!binary) {
+        binary = new Binary(*simout.findOrCreate(filename, true)->stream(),
+                            delta, compress, keyframe, formulas);
+    }
+
+    return binary;
+}
+
+} // namespace Stats
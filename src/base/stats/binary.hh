@@ -0,0 +1,104 @@
+#ifndef __BASE_STATS_BINARY_HH__
+#define __BASE_STATS_BINARY_HH__
+
+#include <cstdint>
+#include <iosfwd>
+#include <stack>
+#include <string>
+#include <vector>
+
+#include "base/stats/info.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace Stats {
+
+/**
+ * Columnar binary stats output. The column names are written once as a
+ * schema record at the first dump, then every dump appends one row of
+ * fixed-width doubles (one per column) with the dump tick.
+ *
+ * A row can be delta-encoded, i.e. each value XORed with the same column
+ * in the previous row, so unchanged stats become zero, and compressed with
+ * zlib. Every keyframe rows is stored without delta so that a reader can
+ * start from there. See util/stats/binary_stats.py for the reader.
+ *
+ * Like the text output, stats without the display flag are skipped.
+ * Sparse histograms are not supported as they are not fixed width.
+ */
+class Binary : public Output
+{
+  public:
+    static constexpr uint32_t Version = 1;
+    static constexpr uint8_t RecordSchema = 'S';
+    static constexpr uint8_t RecordRow = 'R';
+    static constexpr uint8_t RowDelta = 0x1;
+    static constexpr uint8_t RowCompressed = 0x2;
+
+    Binary(std::ostream &stream, bool delta, bool compress,
+           unsigned keyframe, bool formulas);
+
+    Binary() = delete;
+    Binary(const Binary &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    std::ostream &stream;
+    const bool enableDelta;
+    const bool enableCompress;
+    const unsigned keyframe;
+    const bool enableFormula;
+
+    // Object/group path
+    std::stack<std::string> path;
+
+    unsigned dumpCount = 0;
+
+    /**
+     * Column names are only built at the first dump, later dumps just
+     * append the values in the same order.
+     */
+    bool buildSchema = true;
+    std::vector<std::string> names;
+    std::vector<uint64_t> row;
+    std::vector<uint64_t> prevRow;
+    std::vector<uint8_t> buffer;
+    std::vector<uint8_t> compressed;
+
+    bool noOutput(const Info &info) const;
+    std::string statName(const std::string &name) const;
+
+    void append(const std::string &name, Result value);
+    void append(const std::string &name, const std::string &subname,
+                Result value);
+    void appendDist(const std::string &name, const DistData &data);
+    void appendVector(const std::string &name, const VectorInfo &info);
+
+    void writeSchema();
+    void writeRow();
+
+    /** Tick recorded with each row, i.e. the current tick. */
+    virtual Tick dumpTick() const;
+};
+
+Output *initBinary(const std::string &filename, bool delta, bool compress,
+                   unsigned keyframe, bool formulas);
+
+} // namespace Stats
+
+#endif // __BASE_STATS_BINARY_HH__
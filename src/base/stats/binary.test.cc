@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <zlib.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/stats/binary.hh"
+
+namespace {
+
+/** Binary output with a given tick, appending values as scalar stats */
+class TestBinary : public Stats::Binary
+{
+  public:
+    TestBinary(std::ostream &stream, bool delta, bool compress,
+               unsigned keyframe)
+        : Stats::Binary(stream, delta, compress, keyframe, false)
+    {}
+
+    void
+    dump(Tick tick, const std::vector<double> &values)
+    {
+        this->tick = tick;
+        begin();
+        beginGroup("system");
+        for (size_t i = 0; i < values.size(); ++i) {
+            append(statName(csprintf("stat%d", i)), values[i]);
+        }
+        endGroup();
+        end();
+    }
+
+  protected:
+    Tick tick = 0;
+    Tick dumpTick() const override { return tick; }
+};
+
+/** Decoded content of a binary stats file */
+struct Decoded
+{
+    uint32_t version = 0;
+    uint32_t flags = 0;
+    std::vector<std::string> columns;
+    std::vector<Tick> ticks;
+    std::vector<std::vector<double>> rows;
+};
+
+uint64_t
+getBytes(const std::string &data, size_t &pos, int bytes)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(
+            static_cast<uint8_t>(data.at(pos + i))) << (i * 8);
+    }
+    pos += bytes;
+    return value;
+}
+
+Decoded
+decode(const std::string &data)
+{
+    Decoded decoded;
+    EXPECT_EQ(data.substr(0, 8), std::string("GFSTATS\0", 8));
+    size_t pos = 8;
+    decoded.version = getBytes(data, pos, 4);
+    decoded.flags = getBytes(data, pos, 4);
+    std::vector<uint64_t> prev;
+    while (pos < data.size()) {
+        uint8_t record = data.at(pos++);
+        if (record == Stats::Binary::RecordSchema) {
+            auto numColumns = getBytes(data, pos, 4);
+            for (uint64_t i = 0; i < numColumns; ++i) {
+                auto length = getBytes(data, pos, 2);
+                decoded.columns.push_back(data.substr(pos, length));
+                pos += length;
+            }
+        } else if (record == Stats::Binary::RecordRow) {
+            uint8_t flags = data.at(pos++);
+            decoded.ticks.push_back(getBytes(data, pos, 8));
+            auto rawBytes = getBytes(data, pos, 4);
+            auto storedBytes = getBytes(data, pos, 4);
+            std::string payload = data.substr(pos, storedBytes);
+            pos += storedBytes;
+            if (flags & Stats::Binary::RowCompressed) {
+                std::string raw(rawBytes, '\0');
+                uLongf size = rawBytes;
+                EXPECT_EQ(uncompress(
+                    reinterpret_cast<Bytef *>(&raw[0]), &size,
+                    reinterpret_cast<const Bytef *>(payload.data()),
+                    payload.size()), Z_OK);
+                EXPECT_EQ(size, rawBytes);
+                payload = raw;
+            }
+            EXPECT_EQ(payload.size(), rawBytes);
+            std::vector<uint64_t> row;
+            size_t rowPos = 0;
+            while (rowPos < payload.size()) {
+                row.push_back(getBytes(payload, rowPos, 8));
+            }
+            if (flags & Stats::Binary::RowDelta) {
+                EXPECT_EQ(row.size(), prev.size());
+                for (size_t i = 0; i < row.size(); ++i) {
+                    row[i] ^= prev[i];
+                }
+            }
+            std::vector<double> values(row.size());
+            std::memcpy(values.data(), row.data(),
+                        row.size() * sizeof(double));
+            decoded.rows.push_back(values);
+            prev = row;
+        } else {
+            ADD_FAILURE() << "Unknown record " << int(record);
+            break;
+        }
+    }
+    return decoded;
+}
+
+const std::vector<std::vector<double>> testRows = {
+    {0.0, 1.0, 2.5, -3.0},
+    {0.0, 1.0, 3.5, -3.0},
+    {7.0, 1.0, 3.5, 1e20},
+    {7.0, 2.0, 3.5, 1e20},
+    {8.0, 2.0, 0.0, 0.125},
+};
+
+void
+testRoundTrip(bool delta, bool compress, unsigned keyframe)
+{
+    std::stringstream stream;
+    TestBinary binary(stream, delta, compress, keyframe);
+    for (size_t i = 0; i < testRows.size(); ++i) {
+        binary.dump(1000 * (i + 1), testRows[i]);
+    }
+
+    auto decoded = decode(stream.str());
+    EXPECT_EQ(decoded.version, Stats::Binary::Version);
+    uint32_t flags = (delta ? Stats::Binary::RowDelta : 0) |
+                     (compress ? Stats::Binary::RowCompressed : 0);
+    EXPECT_EQ(decoded.flags, flags);
+    ASSERT_EQ(decoded.columns.size(), testRows.front().size());
+    for (size_t i = 0; i < decoded.columns.size(); ++i) {
+        EXPECT_EQ(decoded.columns[i], csprintf("system.stat%d", i));
+    }
+    ASSERT_EQ(decoded.rows.size(), testRows.size());
+    for (size_t i = 0; i < testRows.size(); ++i) {
+        EXPECT_EQ(decoded.ticks[i], 1000 * (i + 1));
+        EXPECT_EQ(decoded.rows[i], testRows[i]);
+    }
+}
+
+} // anonymous namespace
+
+/** Plain rows read back as written */
+TEST(StatsBinaryTest, RoundTrip)
+{
+    testRoundTrip(false, false, 1);
+}
+
+/** XOR-delta rows decode against the previous row and keyframes */
+TEST(StatsBinaryTest, RoundTripDelta)
+{
+    testRoundTrip(true, false, 1);
+    testRoundTrip(true, false, 2);
+    testRoundTrip(true, false, 100);
+}
+
+/** Compressed rows decode to the written values */
+TEST(StatsBinaryTest, RoundTripCompress)
+{
+    testRoundTrip(false, true, 1);
+    testRoundTrip(true, true, 3);
+}
+
+/** The schema is only written once, at the first dump */
+TEST(StatsBinaryTest, SchemaOnce)
+{
+    std::stringstream stream;
+    TestBinary binary(stream, false, false, 1);
+    binary.dump(1, testRows[0]);
+    auto firstSize = stream.str().size();
+    binary.dump(2, testRows[1]);
+    // Second dump is exactly one row: record, flags, tick, sizes, values.
+    EXPECT_EQ(stream.str().size() - firstSize,
+              1 + 1 + 8 + 4 + 4 + testRows[1].size() * sizeof(double));
+}
@@ -68,7 +68,18 @@ class StreamEngine(GemForgeAccelerator):
     totalRunAheadBytes = Param.Unsigned(
         512, "How many bytes to run ahead (default 8 cache lines).")
     throttling = Param.String(
-        "Static", "Which throttling technique to use.")
+        "Static", "Which throttling technique to use "
+        "(static, dynamic, global or utility).")
+    throttlingMaxSizeForOuterLoopStream = Param.Unsigned(
+        8, "Do not throttle outer loop streams beyond this maxSize.")
+    throttlingUtilityEpochCycles = Param.Cycles(
+        2000, "Utility throttling redistributes entries every this cycles.")
+    throttlingUtilityIdleCycles = Param.Cycles(
+        20, "Elements ready this cycles before used are idle.")
+    throttlingUtilityMinEpochSamples = Param.Unsigned(
+        4, "Min sampled elements in an epoch to update the utility.")
+    throttlingUtilityIdleRatio = Param.Float(
+        0.5, "Ratio of idle elements to drop the utility to 0.")
     maxNumElementsPrefetchForAtomic = Param.Unsigned(
         1024, "How many elements to prefetch for atomic stream (default 1024 = no limit).")
     streamEngineEnableLSQ = Param.Bool(
@@ -101,6 +112,16 @@ class StreamEngine(GemForgeAccelerator):
         False, "Whether the stream float is enabled.")
     streamEngineFloatPolicy = Param.String(
         "static", "Policy to choose floating stream.")
+    streamEngineSinkHitRate = Param.Float(
+        0.75, "Adaptive float sinks if private cache hit rate reaches this.")
+    streamEngineSinkPartialHitRate = Param.Float(
+        0.5, "Adaptive float sinks late or far streams above this hit rate.")
+    streamEngineSinkLateRatio = Param.Float(
+        0.5, "Ratio of late floated elements to be considered late.")
+    streamEngineSinkAvgHops = Param.Float(
+        4.0, "Average hops from LLC bank to be considered far.")
+    streamEngineSinkMinFeedbackElements = Param.UInt64(
+        4, "Min floated elements before the late ratio is trusted.")
     streamEngineEnableFloatIndirect = Param.Bool(
         False, "Whether the stream float is enabled for indirect stream.")
     streamEngineEnableFloatPseudo = Param.Bool(
@@ -127,6 +148,13 @@ class StreamEngine(GemForgeAccelerator):
         "Whether enable range-based synchronization between core and LLC SE.")
     enableFloatIndirectReduction = Param.Bool(False,
         "Whether indirect reduction streams can be floated.")
+    enableFloatParallelReduction = Param.Bool(False,
+        "Whether floated direct reduction streams are reduced at each LLC "
+        "bank in parallel and combined along a tree.")
+    enableFloatMultiLevelIndirect = Param.Bool(False,
+        "Whether indirect load chains deeper than one level can be floated.")
+    enableFloatPredicatedReduction = Param.Bool(False,
+        "Whether predicated reduction streams can be floated.")
     enableFloatTwoLevelIndirectStoreCompute = Param.Bool(False,
         "Whether two-level indirect store compute stream can be floated.")
     enableFineGrainedNearDataComputing = Param.Bool(False,
@@ -138,6 +166,11 @@ class StreamEngine(GemForgeAccelerator):
     enableFloatMem = Param.Bool(False, "Whether to enable stream float to mem ctrl.")
     floatLevelPolicy = Param.String("static", "Policy to choose floating level.")
 
+    enableEventTrace = Param.Bool(False,
+        "Trace stream events to a binary file.")
+    eventTraceBufferRecords = Param.Unsigned(65536,
+        "Records per thread buffer of the event tracer.")
+
 class GemForgeAcceleratorManager(SimObject):
     type = 'GemForgeAcceleratorManager'
     cxx_header = 'cpu/gem_forge/accelerator/gem_forge_accelerator.hh'
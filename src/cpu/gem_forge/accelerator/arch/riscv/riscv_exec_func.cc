@@ -2,6 +2,7 @@
 
 #include "../exec_func_context.hh"
 #include "arch/riscv/decoder.hh"
+#include "base/host_profile.hh"
 #include "base/loader/object_file.hh"
 #include "base/loader/symtab.hh"
 #include "cpu/exec_context.hh"
@@ -60,7 +61,10 @@ ExecFunc::ExecFunc(ThreadContext *_tc, const ::LLVM::TDG::ExecFuncInfo &_func)
   }
 }
 
+HOST_PROFILE_COUNTER(hostProfileExecFuncInvoke, "exec_func.invoke");
+
 uint64_t ExecFunc::invoke(const std::vector<uint64_t> &params) {
+  HOST_PROFILE_SCOPE(hostProfileExecFuncInvoke);
   assert(params.size() == this->func.args_size());
   execFuncXC.clear();
   /**
@@ -151,7 +151,7 @@ void ISAStreamEngine::commitStreamConfig(const GemForgeDynInstInfo &dynInfo) {
           configIdx, infoRelativePath,
           mustBeMisspeculatedString(instInfo.mustBeMisspeculatedReason));
   }
-  this->seqNumToDynInfoMap.erase(dynInfo.seqNum);
+  this->commitDynStreamInstInfo(dynInfo.seqNum);
 }
 
 void ISAStreamEngine::rewindStreamConfig(const GemForgeDynInstInfo &dynInfo) {
@@ -164,7 +164,7 @@ void ISAStreamEngine::rewindStreamConfig(const GemForgeDynInstInfo &dynInfo) {
   if (instInfo.mustBeMisspeculated) {
     // Simply do nothing.
     this->curStreamRegionInfo = configInfo.dynStreamRegionInfo->prevRegion;
-    this->seqNumToDynInfoMap.erase(dynInfo.seqNum);
+    this->rewindDynStreamInstInfo(dynInfo.seqNum);
     return;
   }
 
@@ -190,7 +190,7 @@ void ISAStreamEngine::rewindStreamConfig(const GemForgeDynInstInfo &dynInfo) {
   this->removeRegionStreamIds(configIdx, info);
 
   // Release the InstInfo.
-  this->seqNumToDynInfoMap.erase(dynInfo.seqNum);
+  this->rewindDynStreamInstInfo(dynInfo.seqNum);
 }
 
 /********************************************************************************
@@ -295,14 +295,14 @@ void ISAStreamEngine::commitStreamInput(const GemForgeDynInstInfo &dynInfo) {
   if (instInfo.mustBeMisspeculated) {
     panic("[commit] MustMisspeculated StreamInput.\n");
   }
-  this->seqNumToDynInfoMap.erase(dynInfo.seqNum);
+  this->commitDynStreamInstInfo(dynInfo.seqNum);
 }
 
 void ISAStreamEngine::rewindStreamInput(const GemForgeDynInstInfo &dynInfo) {
   auto &instInfo = this->getDynStreamInstInfo(dynInfo.seqNum);
   if (instInfo.mustBeMisspeculated) {
     DYN_INST_DPRINTF("[rewind] MustMisspeculated StreamInput.\n");
-    this->seqNumToDynInfoMap.erase(dynInfo.seqNum);
+    this->rewindDynStreamInstInfo(dynInfo.seqNum);
     return;
   }
   auto &configInfo = instInfo.configInfo;
@@ -327,7 +327,7 @@ void ISAStreamEngine::rewindStreamInput(const GemForgeDynInstInfo &dynInfo) {
   inputVec.pop_back();
 
   // Release the InstInfo.
-  this->seqNumToDynInfoMap.erase(dynInfo.seqNum);
+  this->rewindDynStreamInstInfo(dynInfo.seqNum);
 }
 
 /********************************************************************************
@@ -438,7 +438,7 @@ void ISAStreamEngine::commitStreamReady(const GemForgeDynInstInfo &dynInfo) {
   DYN_INST_DPRINTF("[commit] StreamReady %s.\n", infoRelativePath);
 
   // Release the InstInfo.
-  this->seqNumToDynInfoMap.erase(dynInfo.seqNum);
+  this->commitDynStreamInstInfo(dynInfo.seqNum);
 }
 
 void ISAStreamEngine::rewindStreamReady(const GemForgeDynInstInfo &dynInfo) {
@@ -452,7 +452,7 @@ void ISAStreamEngine::rewindStreamReady(const GemForgeDynInstInfo &dynInfo) {
     this->curStreamRegionInfo = regionInfo;
 
     // Release the InstInfo.
-    this->seqNumToDynInfoMap.erase(dynInfo.seqNum);
+    this->rewindDynStreamInstInfo(dynInfo.seqNum);
     return;
   }
 
@@ -481,7 +481,7 @@ void ISAStreamEngine::rewindStreamReady(const GemForgeDynInstInfo &dynInfo) {
   this->curStreamRegionInfo = regionInfo;
 
   // Release the InstInfo.
-  this->seqNumToDynInfoMap.erase(dynInfo.seqNum);
+  this->rewindDynStreamInstInfo(dynInfo.seqNum);
 }
 
 /********************************************************************************
@@ -606,7 +606,7 @@ void ISAStreamEngine::commitStreamEnd(const GemForgeDynInstInfo &dynInfo) {
   se->commitStreamEnd(args);
 
   // Release the info.
-  this->seqNumToDynInfoMap.erase(dynInfo.seqNum);
+  this->commitDynStreamInstInfo(dynInfo.seqNum);
 }
 
 void ISAStreamEngine::rewindStreamEnd(const GemForgeDynInstInfo &dynInfo) {
@@ -630,7 +630,7 @@ void ISAStreamEngine::rewindStreamEnd(const GemForgeDynInstInfo &dynInfo) {
   }
 
   // Release the info.
-  this->seqNumToDynInfoMap.erase(dynInfo.seqNum);
+  this->rewindDynStreamInstInfo(dynInfo.seqNum);
 }
 
 /********************************************************************************
@@ -641,12 +641,11 @@ bool ISAStreamEngine::canDispatchStreamStep(
     const GemForgeDynInstInfo &dynInfo) {
   // First create the memorized info.
   auto regionStreamId = this->extractImm<uint64_t>(dynInfo.staticInst);
-  auto emplaceRet = this->seqNumToDynInfoMap.emplace(
-      std::piecewise_construct, std::forward_as_tuple(dynInfo.seqNum),
-      std::forward_as_tuple());
-  auto &instInfo = emplaceRet.first->second;
+  bool created = false;
+  auto &instInfo =
+      this->getOrCreateDynStreamInstInfo(dynInfo.seqNum, created);
   auto &stepInstInfo = instInfo.stepInfo;
-  if (emplaceRet.second) {
+  if (created) {
     // First time. Translate the regionStreamId.
     if (!this->isValidRegionStreamId(regionStreamId)) {
       DYN_INST_DPRINTF(
@@ -684,6 +683,7 @@ void ISAStreamEngine::dispatchStreamStep(
   auto regionStreamId = this->extractImm<uint64_t>(dynInfo.staticInst);
 
   auto &instInfo = this->getDynStreamInstInfo(dynInfo.seqNum);
+  instInfo.dispatched = true;
   if (instInfo.mustBeMisspeculated) {
     return;
   }
@@ -750,7 +750,7 @@ void ISAStreamEngine::commitStreamStep(const GemForgeDynInstInfo &dynInfo) {
   DYN_INST_DPRINTF("[commit] StreamStep RegionStream %llu.\n", regionStreamId);
 
   // Release the info.
-  this->seqNumToDynInfoMap.erase(dynInfo.seqNum);
+  this->commitDynStreamInstInfo(dynInfo.seqNum);
 }
 
 void ISAStreamEngine::rewindStreamStep(const GemForgeDynInstInfo &dynInfo) {
@@ -766,7 +766,7 @@ void ISAStreamEngine::rewindStreamStep(const GemForgeDynInstInfo &dynInfo) {
   }
 
   // Release the info.
-  this->seqNumToDynInfoMap.erase(dynInfo.seqNum);
+  this->rewindDynStreamInstInfo(dynInfo.seqNum);
 }
 
 /********************************************************************************
@@ -897,12 +897,11 @@ bool ISAStreamEngine::canDispatchStreamUser(const GemForgeDynInstInfo &dynInfo,
   auto regionStreamId = this->extractImm<uint64_t>(dynInfo.staticInst);
 
   // First create the memorized info.
-  auto emplaceRet = this->seqNumToDynInfoMap.emplace(
-      std::piecewise_construct, std::forward_as_tuple(dynInfo.seqNum),
-      std::forward_as_tuple());
-  auto &dynStreamInstInfo = emplaceRet.first->second;
+  bool created = false;
+  auto &dynStreamInstInfo =
+      this->getOrCreateDynStreamInstInfo(dynInfo.seqNum, created);
   auto &userInfo = dynStreamInstInfo.userInfo;
-  if (emplaceRet.second) {
+  if (created) {
     // First time. Translate the regionStreamId.
     if (this->isValidRegionStreamId(regionStreamId)) {
       auto streamId = this->lookupRegionStreamId(regionStreamId);
@@ -958,6 +957,7 @@ void ISAStreamEngine::dispatchStreamUser(
 
   auto &instInfo = this->getDynStreamInstInfo(dynInfo.seqNum);
   auto &userInfo = instInfo.userInfo;
+  instInfo.dispatched = true;
 
   if (instInfo.mustBeMisspeculated) {
     // This is a must be misspeculated instruction.
@@ -1040,7 +1040,7 @@ void ISAStreamEngine::commitStreamUser(const GemForgeDynInstInfo &dynInfo,
   se->commitStreamUser(args);
 
   // Release the info.
-  this->seqNumToDynInfoMap.erase(dynInfo.seqNum);
+  this->commitDynStreamInstInfo(dynInfo.seqNum);
 }
 
 void ISAStreamEngine::rewindStreamUser(const GemForgeDynInstInfo &dynInfo,
@@ -1061,7 +1061,7 @@ void ISAStreamEngine::rewindStreamUser(const GemForgeDynInstInfo &dynInfo,
   }
 
   // Release the info.
-  this->seqNumToDynInfoMap.erase(dynInfo.seqNum);
+  this->rewindDynStreamInstInfo(dynInfo.seqNum);
 }
 
 /********************************************************************************
@@ -1297,31 +1297,119 @@ uint64_t ISAStreamEngine::lookupRegionStreamId(int regionStreamId) const {
   return streamId;
 }
 
+CircularQueue<ISAStreamEngine::DynStreamInstInfoEntry> &
+ISAStreamEngine::getDynInfoQueue() {
+  if (!this->dynInfoQueue) {
+    this->dynInfoQueue =
+        m5::make_unique<CircularQueue<DynStreamInstInfoEntry>>(
+            cpuDelegator->getMaxInflyInsts() + 1);
+  }
+  return *this->dynInfoQueue;
+}
+
 ISAStreamEngine::DynStreamInstInfo &
 ISAStreamEngine::createDynStreamInstInfo(uint64_t seqNum) {
-  auto emplaceRet = this->seqNumToDynInfoMap.emplace(
-      std::piecewise_construct, std::forward_as_tuple(seqNum),
-      std::forward_as_tuple());
-  assert(emplaceRet.second && "StreamInstInfo already there.");
-  return emplaceRet.first->second;
+  this->dropUndispatchedDynStreamInstInfo(seqNum);
+  auto &queue = this->getDynInfoQueue();
+  if (!queue.empty() && queue.back().seqNum >= seqNum) {
+    ISA_SE_PANIC("StreamInstInfo %llu created out of order, tail %llu.",
+                 seqNum, queue.back().seqNum);
+  }
+  if (queue.full()) {
+    ISA_SE_PANIC("Too many infly stream insts %d, CPU MaxInflyInsts %d.",
+                 queue.size(), cpuDelegator->getMaxInflyInsts());
+  }
+  // Reset the reused entry.
+  queue.advance_tail();
+  queue.back() = DynStreamInstInfoEntry();
+  queue.back().seqNum = seqNum;
+  queue.back().info.dispatched = true;
+  return queue.back().info;
 }
 
 ISAStreamEngine::DynStreamInstInfo &
-ISAStreamEngine::getOrCreateDynStreamInstInfo(uint64_t seqNum) {
-  auto emplaceRet = this->seqNumToDynInfoMap.emplace(
-      std::piecewise_construct, std::forward_as_tuple(seqNum),
-      std::forward_as_tuple());
-  return emplaceRet.first->second;
+ISAStreamEngine::getOrCreateDynStreamInstInfo(uint64_t seqNum,
+                                              bool &created) {
+  /**
+   * Only used in canDispatch, which may be called multiple times for the
+   * same instruction. It must be the youngest one.
+   */
+  auto &queue = this->getDynInfoQueue();
+  if (!queue.empty() && queue.back().seqNum == seqNum) {
+    created = false;
+    return queue.back().info;
+  }
+  created = true;
+  auto &info = this->createDynStreamInstInfo(seqNum);
+  info.dispatched = false;
+  return info;
+}
+
+ISAStreamEngine::DynStreamInstInfoEntry *
+ISAStreamEngine::findDynStreamInstInfo(uint64_t seqNum) {
+  auto &queue = this->getDynInfoQueue();
+  if (queue.empty()) {
+    return nullptr;
+  }
+  // Fast path: the youngest and the oldest.
+  if (queue.back().seqNum == seqNum) {
+    return &queue.back();
+  }
+  if (queue.front().seqNum == seqNum) {
+    return &queue.front();
+  }
+  // Binary search as the queue is sorted by seqNum.
+  size_t lhs = 0;
+  size_t rhs = queue.size();
+  while (lhs < rhs) {
+    auto mid = (lhs + rhs) / 2;
+    auto &entry = queue[queue.moduloAdd(queue.head(), mid)];
+    if (entry.seqNum == seqNum) {
+      return &entry;
+    } else if (entry.seqNum < seqNum) {
+      lhs = mid + 1;
+    } else {
+      rhs = mid;
+    }
+  }
+  return nullptr;
 }
 
 ISAStreamEngine::DynStreamInstInfo &
 ISAStreamEngine::getDynStreamInstInfo(uint64_t seqNum) {
-  auto iter = this->seqNumToDynInfoMap.find(seqNum);
-  if (iter == this->seqNumToDynInfoMap.end()) {
+  auto entry = this->findDynStreamInstInfo(seqNum);
+  if (!entry) {
     inform("Failed to get DynStreamInstInfo for %llu.", seqNum);
     assert(false && "Failed to get DynStreamInstInfo.");
   }
-  return iter->second;
+  return entry->info;
+}
+
+void ISAStreamEngine::commitDynStreamInstInfo(uint64_t seqNum) {
+  auto &queue = this->getDynInfoQueue();
+  assert(!queue.empty() && queue.front().seqNum == seqNum &&
+         "StreamInstInfo not committed in order.");
+  // Release the DynStreamRegionInfo.
+  queue.front() = DynStreamInstInfoEntry();
+  queue.pop_front();
+}
+
+void ISAStreamEngine::rewindDynStreamInstInfo(uint64_t seqNum) {
+  this->dropUndispatchedDynStreamInstInfo(seqNum);
+  auto &queue = this->getDynInfoQueue();
+  assert(!queue.empty() && queue.back().seqNum == seqNum &&
+         "StreamInstInfo not rewound in order.");
+  queue.back() = DynStreamInstInfoEntry();
+  queue.pop_back();
+}
+
+void ISAStreamEngine::dropUndispatchedDynStreamInstInfo(uint64_t seqNum) {
+  auto &queue = this->getDynInfoQueue();
+  if (!queue.empty() && queue.back().seqNum != seqNum &&
+      !queue.back().info.dispatched) {
+    queue.back() = DynStreamInstInfoEntry();
+    queue.pop_back();
+  }
 }
 
 void ISAStreamEngine::increamentStreamRegionInfoNumExecutedInsts(
@@ -1384,6 +1472,21 @@ ISAStreamEngine::mustBeMisspeculatedString(MustBeMisspeculatedReason reason) {
 
 void ISAStreamEngine::takeOverBy(GemForgeCPUDelegator *newDelegator) {
   this->cpuDelegator = newDelegator;
+  /**
+   * The CPU is drained, so only an undispatched info can be left. Release
+   * the queue so that it is sized for the new CPU.
+   */
+  if (this->dynInfoQueue) {
+    auto &queue = *this->dynInfoQueue;
+    if (!queue.empty() && !queue.back().info.dispatched) {
+      queue.back() = DynStreamInstInfoEntry();
+      queue.pop_back();
+    }
+    if (!queue.empty()) {
+      ISA_SE_PANIC("TakeOver with %d infly stream insts.", queue.size());
+    }
+    this->dynInfoQueue = nullptr;
+  }
   // Clear memorized StreamEngine, even though by our design this should not
   // change.
   this->SE = nullptr;
@@ -1392,6 +1495,10 @@ void ISAStreamEngine::takeOverBy(GemForgeCPUDelegator *newDelegator) {
 
 void ISAStreamEngine::reset() {
   this->regionStreamIdTableStack.clear();
-  this->seqNumToDynInfoMap.clear();
+  auto &queue = this->getDynInfoQueue();
+  while (!queue.empty()) {
+    queue.front() = DynStreamInstInfoEntry();
+    queue.pop_front();
+  }
   this->curStreamRegionInfo = nullptr;
 }
\ No newline at end of file
@@ -15,6 +15,7 @@
 #error "Require protobuf to parse stream info."
 #endif
 
+#include "base/circular_queue.hh"
 #include "cpu/gem_forge/accelerator/arch/exec_func.hh"
 #include "cpu/gem_forge/accelerator/stream/StreamMessage.pb.h"
 
@@ -237,6 +238,12 @@ private:
      * Sometimes it is for sure this instruction is misspeculated.
      */
     bool mustBeMisspeculated = false;
+    /**
+     * Whether this instruction has been dispatched. StreamStep and
+     * StreamUser create the info in canDispatch, which may be squashed
+     * before dispatched.
+     */
+    bool dispatched = false;
     /**
      * Whether this instruction has been executed.
      * Only valid if mustBeMisspeculated is false.
@@ -244,11 +251,37 @@ private:
     bool executed = false;
     MustBeMisspeculatedReason mustBeMisspeculatedReason;
   };
-  std::unordered_map<uint64_t, DynStreamInstInfo> seqNumToDynInfoMap;
+
+  /**
+   * Stream instructions are dispatched in order, committed from the head
+   * and rewound from the tail, so their DynStreamInstInfo are kept in a
+   * circular queue sorted by seqNum instead of a hash map. Lookups hit the
+   * head or the tail most of the time, and fall back to a binary search.
+   * The capacity only needs to cover the in-flight stream instructions,
+   * i.e. the CPU's max infly instructions (e.g. ROB), plus one created in
+   * canDispatch but not yet dispatched. It is allocated lazily as the
+   * delegator is still under construction here, and again after a
+   * takeover.
+   */
+  struct DynStreamInstInfoEntry {
+    uint64_t seqNum = 0;
+    DynStreamInstInfo info;
+  };
+  std::unique_ptr<CircularQueue<DynStreamInstInfoEntry>> dynInfoQueue;
+  CircularQueue<DynStreamInstInfoEntry> &getDynInfoQueue();
 
   DynStreamInstInfo &createDynStreamInstInfo(uint64_t seqNum);
-  DynStreamInstInfo &getOrCreateDynStreamInstInfo(uint64_t seqNum);
+  DynStreamInstInfo &getOrCreateDynStreamInstInfo(uint64_t seqNum,
+                                                  bool &created);
   DynStreamInstInfo &getDynStreamInstInfo(uint64_t seqNum);
+  DynStreamInstInfoEntry *findDynStreamInstInfo(uint64_t seqNum);
+  void commitDynStreamInstInfo(uint64_t seqNum);
+  void rewindDynStreamInstInfo(uint64_t seqNum);
+  /**
+   * Drop the info at the tail that is never dispatched, i.e. squashed
+   * after canDispatch.
+   */
+  void dropUndispatchedDynStreamInstInfo(uint64_t seqNum);
 
   /**
    * Mark one stream config inst executed.
@@ -4,6 +4,7 @@
 #include "arch/x86/decoder.hh"
 #include "arch/x86/insts/macroop.hh"
 #include "arch/x86/regs/float.hh"
+#include "base/host_profile.hh"
 #include "base/loader/object_file.hh"
 #include "base/loader/symtab.hh"
 #include "cpu/exec_context.hh"
@@ -196,9 +197,12 @@ std::string ExecFunc::RegisterValue::print() const {
   return GemForgeUtils::dataToString(this->uint8Ptr(), sizeof(*this));
 }
 
+HOST_PROFILE_COUNTER(hostProfileExecFuncInvoke, "exec_func.invoke");
+
 ExecFunc::RegisterValue
 ExecFunc::invoke(const std::vector<RegisterValue> &params,
                  GemForgeISAHandler *isaHandler, InstSeqNum startSeqNum) {
+  HOST_PROFILE_SCOPE(hostProfileExecFuncInvoke);
   /**
    * We are assuming C calling convention.
    * Registers are passed in as $rdi, $rsi, $rdx, $rcx, $r8, $r9.
@@ -304,6 +308,7 @@ ExecFunc::invoke(const std::vector<RegisterValue> &params,
 }
 
 Addr ExecFunc::invoke(const std::vector<Addr> &params) {
+  HOST_PROFILE_SCOPE(hostProfileExecFuncInvoke);
   /**
    * We are assuming C calling convention.
    * Registers are passed in as $rdi, $rsi, $rdx, $rcx, $r8, $r9.
@@ -105,6 +105,12 @@ public:
    * Whether the core need the final value.
    */
   bool finalValueNeededByCore = false;
+  /**
+   * Whether this DirectReductionStream is reduced in parallel: each LLC bank
+   * reduces its own elements without waiting for the previous bank, and the
+   * partial results are combined along a tree at the end.
+   */
+  bool isParallelReduction = false;
 
   /**
    * Whether this is a pointer chase stream.
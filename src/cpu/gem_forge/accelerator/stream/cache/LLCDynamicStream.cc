@@ -7,6 +7,7 @@
 
 #include "cpu/gem_forge/accelerator/stream/stream.hh"
 #include "cpu/gem_forge/accelerator/stream/stream_engine.hh"
+#include "cpu/gem_forge/accelerator/stream/stream_event_tracer.hh"
 #include "cpu/gem_forge/llvm_trace_cpu.hh"
 #include "mem/ruby/slicc_interface/AbstractStreamAwareController.hh"
 
@@ -18,6 +19,9 @@
 #define DEBUG_TYPE LLCRubyStreamBase
 #include "../stream_log.hh"
 
+#include <cstdlib>
+#include <limits>
+
 std::unordered_map<DynamicStreamId, LLCDynamicStream *, DynamicStreamIdHasher>
     LLCDynamicStream::GlobalLLCDynamicStreamMap;
 std::unordered_map<NodeID, std::list<std::vector<LLCDynamicStream *>>>
@@ -259,6 +263,24 @@ void LLCDynamicStream::traceEvent(
   assert(this->llcController && "Missing LLCController when tracing event.");
   auto machineId = this->llcController->getMachineID();
   floatTracer.traceEvent(curCycle, machineId, type);
+  if (StreamEventTracer::isEnabled()) {
+    StreamEventTracer::EventType eventType = StreamEventTracer::LLCConfig;
+    switch (type) {
+    default:
+      break;
+    case ::LLVM::TDG::StreamFloatEvent::END:
+      eventType = StreamEventTracer::LLCEnd;
+      break;
+    case ::LLVM::TDG::StreamFloatEvent::MIGRATE_IN:
+      eventType = StreamEventTracer::LLCMigrateIn;
+      break;
+    case ::LLVM::TDG::StreamFloatEvent::MIGRATE_OUT:
+      eventType = StreamEventTracer::LLCMigrateOut;
+      break;
+    }
+    StreamEventTracer::trace(eventType, this->getDynamicStreamId(),
+                             this->getNextInitElementIdx(), machineId.num);
+  }
   // Do this for all indirect streams.
   for (auto IS : this->getIndStreams()) {
     IS->traceEvent(type);
@@ -548,15 +570,18 @@ void LLCDynamicStream::initNextElement(Addr vaddr) {
      * IndirectReductionStream is handled differently, as their computation
      * latency is charged at each indirect banks, but to keep things simple,
      * the real computation is still carried out serially.
+     * ParallelReductionStream is the same, except that the banks are the
+     * ones holding the direct base elements.
      *
      * Therefore, we do not add PrevReductionElement as the base element for
-     * IndirectReductionStream. Also, since the compute value is not truly
-     * ready, we have to avoid any user of the reduction value.
+     * Indirect/ParallelReductionStream. Also, since the compute value is not
+     * truly ready, we have to avoid any user of the reduction value.
      */
-    if (this->isIndirectReduction()) {
+    if (this->isDeferredReduction()) {
       if (!this->configData->depEdges.empty()) {
         LLC_S_PANIC(this->getDynamicStreamId(),
-                    "Dependence of IndirectReductionStream is not supported.");
+                    "Dependence of Indirect/ParallelReductionStream is not "
+                    "supported.");
       }
     } else {
       // Direct reduction.
@@ -916,35 +941,8 @@ LLCDynamicStreamPtr LLCDynamicStream::allocateLLCStream(
   auto S = new LLCDynamicStream(mlcController, llcController, config);
 
   // Check if we have indirect streams.
-  for (const auto &edge : config->depEdges) {
-    if (edge.type != CacheStreamConfigureData::DepEdge::Type::UsedBy) {
-      continue;
-    }
-    auto &ISConfig = edge.data;
-    // Let's create an indirect stream.
-    ISConfig->initCreditedIdx = config->initCreditedIdx;
-    auto IS = new LLCDynamicStream(mlcController, llcController, ISConfig);
-    IS->setBaseStream(S);
-    for (const auto &ISDepEdge : ISConfig->depEdges) {
-      if (ISDepEdge.type != CacheStreamConfigureData::DepEdge::UsedBy) {
-        continue;
-      }
-      /**
-       * So far we don't support Two-Level Indirect LLCStream, except:
-       * 1. IndirectRedcutionStream.
-       * 2. Two-Level IndirectStoreComputeStream.
-       */
-      auto ISDepS = ISDepEdge.data->stream;
-      if (ISDepS->isReduction() || ISDepS->isStoreComputeStream()) {
-        auto IIS =
-            new LLCDynamicStream(mlcController, llcController, ISDepEdge.data);
-        IIS->setBaseStream(IS);
-        continue;
-      }
-      panic("Two-Level Indirect LLCStream is not supported: %s.",
-            IS->getDynamicStreamId());
-    }
-  }
+  LLCDynamicStream::allocateIndirectLLCStreams(mlcController, llcController,
+                                               S);
 
   // Create predicated stream information.
   assert(!config->isPredicated && "Base stream should never be predicated.");
@@ -965,6 +963,38 @@ LLCDynamicStreamPtr LLCDynamicStream::allocateLLCStream(
   return S;
 }
 
+void LLCDynamicStream::allocateIndirectLLCStreams(
+    AbstractStreamAwareController *mlcController,
+    AbstractStreamAwareController *llcController, LLCDynamicStreamPtr baseS) {
+  for (const auto &edge : baseS->configData->depEdges) {
+    if (edge.type != CacheStreamConfigureData::DepEdge::Type::UsedBy) {
+      continue;
+    }
+    auto &ISConfig = edge.data;
+    if (baseS->isIndirect()) {
+      /**
+       * Multi-Level Indirect LLCStream is limited to:
+       * 1. IndirectRedcutionStream.
+       * 2. Two-Level IndirectStoreComputeStream.
+       * 3. Chained IndirectLoadStream.
+       */
+      auto ISDepS = ISConfig->stream;
+      if (!ISDepS->isReduction() && !ISDepS->isStoreComputeStream() &&
+          !ISDepS->isLoadStream()) {
+        panic("Multi-Level Indirect LLCStream is not supported: %s.",
+              ISConfig->dynamicId);
+      }
+    } else {
+      ISConfig->initCreditedIdx = baseS->configData->initCreditedIdx;
+    }
+    // Let's create an indirect stream.
+    auto IS = new LLCDynamicStream(mlcController, llcController, ISConfig);
+    IS->setBaseStream(baseS);
+    LLCDynamicStream::allocateIndirectLLCStreams(mlcController, llcController,
+                                                 IS);
+  }
+}
+
 void LLCDynamicStream::setBaseStream(LLCDynamicStreamPtr baseS) {
   if (this->baseStream) {
     LLC_S_PANIC(this->getDynamicStreamId(),
@@ -1019,7 +1049,9 @@ StreamValue LLCDynamicStream::computeStreamElementValue(
   auto getStreamValue = [&element](uint64_t baseStreamId) -> StreamValue {
     return element->getValueByStreamId(baseStreamId);
   };
-  if (S->isReduction() || S->isPointerChaseIndVar()) {
+  if (S->isMergeStream()) {
+    return this->computeMergeStreamElementValue(element);
+  } else if (S->isReduction() || S->isPointerChaseIndVar()) {
     // This is a reduction stream.
     assert(element->idx > 0 &&
            "Reduction stream ElementIdx should start at 1.");
@@ -1037,6 +1069,22 @@ StreamValue LLCDynamicStream::computeStreamElementValue(
       return element->getBaseStreamValue(baseStreamId);
     };
 
+    /**
+     * PredicatedReduction evaluates the predicate first, and carries
+     * forward the previous value if false.
+     */
+    if (S->isPredicatedReduction()) {
+      auto predParams = convertFormalParamToParam(
+          config->predFormalParams, getBaseOrPrevReductionStreamValue);
+      bool predTrue = config->predCallback->invoke(predParams).front() & 0x1;
+      if (!predTrue) {
+        S->statistic.numLLCPredicatedReductionSkip++;
+        LLC_ELEMENT_DPRINTF_(LLCRubyStreamReduce, element,
+                             "[PredicatedReduction] Not reduced.\n");
+        return getBaseOrPrevReductionStreamValue(S->staticId);
+      }
+    }
+
     Cycles latency = config->addrGenCallback->getEstimatedLatency();
     auto newReductionValue = config->addrGenCallback->genAddr(
         element->idx, config->addrGenFormalParams,
@@ -1107,6 +1155,106 @@ StreamValue LLCDynamicStream::computeStreamElementValue(
   }
 }
 
+StreamValue LLCDynamicStream::computeMergeStreamElementValue(
+    const LLCStreamElementPtr &element) {
+  auto S = element->S;
+  const auto &config = this->configData;
+  assert(element->idx > 0 && "MergeStream ElementIdx should start at 1.");
+  auto prevReductionElement = element->getPrevReductionElement();
+  assert(prevReductionElement && "Missing prev reduction element.");
+  assert(prevReductionElement->isReady() &&
+         "Prev reduction element is not ready.");
+  auto reductionValue = prevReductionElement->getValueByStreamId(S->staticId);
+
+  /**
+   * The key streams are still forwarded here in lockstep, and we buffer the
+   * new keys from both of them.
+   */
+  const auto &mergeStreams = S->getMergeStreams();
+  std::array<uint64_t, 2> keyStreamIds;
+  for (int i = 0; i < 2; ++i) {
+    keyStreamIds[i] = mergeStreams.Get(i).id();
+    this->mergeKeys[i].push_back(element->getBaseStreamValue(keyStreamIds[i]));
+  }
+
+  /**
+   * Reduce over one key. For union, an unmatched key is passed to both
+   * key arguments of the reduce function.
+   */
+  const bool isUnion =
+      S->getMergeOp() == ::LLVM::TDG::StreamMergeInfo_MergeOp_UNION;
+  int numComparisons = 0;
+  int numMatches = 0;
+  auto reduce = [&](const StreamValue &keyA, const StreamValue &keyB) -> void {
+    auto getKeyOrPrevReductionValue = [&](uint64_t streamId) -> StreamValue {
+      if (streamId == keyStreamIds[0]) {
+        return keyA;
+      }
+      if (streamId == keyStreamIds[1]) {
+        return keyB;
+      }
+      if (S->isCoalescedHere(streamId)) {
+        return reductionValue;
+      }
+      LLC_ELEMENT_PANIC(element, "MergeStream reduce on non-key stream %lu.",
+                        streamId);
+    };
+    reductionValue = config->addrGenCallback->genAddr(
+        element->idx, config->addrGenFormalParams, getKeyOrPrevReductionValue);
+    numMatches++;
+  };
+
+  // Walk until either side runs out of keys.
+  auto &keysA = this->mergeKeys[0];
+  auto &keysB = this->mergeKeys[1];
+  while (!keysA.empty() && !keysB.empty()) {
+    numComparisons++;
+    auto keyA = keysA.front().front();
+    auto keyB = keysB.front().front();
+    if (keyA == keyB) {
+      reduce(keysA.front(), keysB.front());
+      keysA.pop_front();
+      keysB.pop_front();
+    } else if (keyA < keyB) {
+      if (isUnion) {
+        reduce(keysA.front(), keysA.front());
+      }
+      keysA.pop_front();
+    } else {
+      if (isUnion) {
+        reduce(keysB.front(), keysB.front());
+      }
+      keysB.pop_front();
+    }
+  }
+
+  // All keys have arrived at the last element, drain the remaining ones.
+  if (element->idx == this->getTotalTripCount()) {
+    for (auto &keys : this->mergeKeys) {
+      while (!keys.empty()) {
+        if (isUnion) {
+          reduce(keys.front(), keys.front());
+        }
+        keys.pop_front();
+      }
+    }
+  }
+
+  // One cycle per comparison, plus the reduce function per matched key.
+  const int compareLatency = 1;
+  this->lastMergeLatency =
+      Cycles(compareLatency * numComparisons +
+             config->addrGenCallback->getEstimatedLatency() * numMatches);
+  S->statistic.numLLCMergeComparison += numComparisons;
+  S->statistic.numLLCMergeMatch += numMatches;
+
+  LLC_ELEMENT_DPRINTF_(LLCRubyStreamReduce, element,
+                       "[Merge] Compare %d Match %d Buffered %llu %llu -> %s.\n",
+                       numComparisons, numMatches, keysA.size(), keysB.size(),
+                       reductionValue);
+  return reductionValue;
+}
+
 void LLCDynamicStream::completeComputation(LLCStreamEngine *se,
                                            const LLCStreamElementPtr &element,
                                            const StreamValue &value) {
@@ -1115,13 +1263,14 @@ void LLCDynamicStream::completeComputation(LLCStreamEngine *se,
   /**
    * LoadCompute/Update store computed value in ComputedValue.
    * AtomicComputeStream has no computed value.
-   * IndirectReductionStream separates compuation from charging the latency.
+   * Indirect/ParallelReductionStream separates compuation from charging the
+   * latency.
    */
   if (S->isLoadComputeStream() || S->isUpdateStream()) {
     element->setComputedValue(value);
   } else if (S->isAtomicComputeStream()) {
 
-  } else if (!this->isIndirectReduction()) {
+  } else if (!this->isDeferredReduction()) {
     element->setValue(value);
   }
   this->incompleteComputations--;
@@ -1178,11 +1327,15 @@ void LLCDynamicStream::completeComputation(LLCStreamEngine *se,
     se->postProcessIndirectAtomicSlice(this, element);
 
   } else if (S->isReduction() || S->isPointerChaseIndVar()) {
-    if (this->isIndirectReduction()) {
+    if (this->isParallelReduction()) {
+      // This bank now holds a partial result.
+      this->parallelReductionBanks.insert(seMachineID.getNum());
+    }
+    if (this->isDeferredReduction()) {
       /**
-       * If this is IndirectReductionStream, perform the real computation.
-       * Notice that here we charge zero latency, as we already charged it
-       * when schedule the computation.
+       * If this is Indirect/ParallelReductionStream, perform the real
+       * computation. Notice that here we charge zero latency, as we already
+       * charged it when schedule the computation.
        */
       LLC_S_DPRINTF_(LLCRubyStreamReduce, this->getDynamicStreamId(),
                      "[IndirectReduction] Start real computation from "
@@ -1279,11 +1432,28 @@ void LLCDynamicStream::completeComputation(LLCStreamEngine *se,
       int payloadSize = S->getCoreElementSize();
       int lineOffset = 0;
       bool forceIdea = false;
-      se->issueStreamDataToMLC(sliceId, paddrLine,
-                               finalReductionValue.uint8Ptr(), dataSize,
-                               payloadSize, lineOffset, forceIdea);
+      /**
+       * ParallelReduction first combines the partial results along the tree,
+       * and the root bank sends back the final value.
+       */
+      LLCStreamEngine *finalSE = se;
+      Cycles treeLatency(0);
+      if (this->isParallelReduction()) {
+        treeLatency =
+            this->getParallelReductionTreeLatency(seMachineID.getNum());
+        MachineID rootMachineID(seMachineID.getType(),
+                                this->getParallelReductionRootBank());
+        finalSE = AbstractStreamAwareController::getController(rootMachineID)
+                      ->getLLCStreamEngine();
+      }
+      finalSE->issueStreamDataToMLC(sliceId, paddrLine,
+                                    finalReductionValue.uint8Ptr(), dataSize,
+                                    payloadSize, lineOffset, forceIdea,
+                                    treeLatency);
       LLC_ELEMENT_DPRINTF_(LLCRubyStreamReduce, finalReductionElement,
-                           "Send back final reduction.\n");
+                           "Send back final reduction. Banks %llu "
+                           "TreeLatency %llu.\n",
+                           this->parallelReductionBanks.size(), treeLatency);
     }
 
     /**
@@ -1299,6 +1469,62 @@ void LLCDynamicStream::completeComputation(LLCStreamEngine *se,
   }
 }
 
+int LLCDynamicStream::getParallelReductionRootBank() const {
+  const int cols = this->mlcController->getNumCols();
+  const int mlcBank = this->getDynamicStreamId().coreId;
+  int rootBank = *this->parallelReductionBanks.begin();
+  int rootHops = std::numeric_limits<int>::max();
+  for (auto bank : this->parallelReductionBanks) {
+    int hops = std::abs(bank / cols - mlcBank / cols) +
+               std::abs(bank % cols - mlcBank % cols);
+    if (hops < rootHops) {
+      rootBank = bank;
+      rootHops = hops;
+    }
+  }
+  return rootBank;
+}
+
+Cycles LLCDynamicStream::getParallelReductionTreeLatency(int lastBank) const {
+  /**
+   * The root is the first, and other banks are paired by their id, so that
+   * the pairs at lower levels are close in the mesh. At each level, the
+   * partial result of the last bank travels to its pair and is combined.
+   */
+  const Cycles hopLatency = this->mlcController->getHopLatency();
+  const int cols = this->mlcController->getNumCols();
+  const int rootBank = this->getParallelReductionRootBank();
+  std::vector<int> banks;
+  banks.push_back(rootBank);
+  for (auto bank : this->parallelReductionBanks) {
+    if (bank != rootBank) {
+      banks.push_back(bank);
+    }
+  }
+  auto lastIter = std::find(banks.begin(), banks.end(), lastBank);
+  if (lastIter == banks.end()) {
+    LLC_S_PANIC(this->getDynamicStreamId(),
+                "LastBank %d holds no partial result.", lastBank);
+  }
+  size_t pos = lastIter - banks.begin();
+  Cycles combineLatency =
+      this->getStaticStream()->getEstimatedComputationLatency();
+  Cycles latency(0);
+  for (size_t stride = 1; stride < banks.size(); stride *= 2) {
+    size_t pair = (pos % (2 * stride) == 0) ? (pos + stride) : (pos - stride);
+    if (pair >= banks.size()) {
+      // No pair at this level.
+      continue;
+    }
+    int a = banks[pos];
+    int b = banks[pair];
+    int hops = std::abs(a / cols - b / cols) + std::abs(a % cols - b % cols);
+    latency += Cycles(hops * hopLatency) + combineLatency;
+    pos = std::min(pos, pair);
+  }
+  return latency;
+}
+
 void LLCDynamicStream::addCommitMessage(const DynamicStreamSliceId &sliceId) {
   auto iter = this->commitMessages.begin();
   auto end = this->commitMessages.end();
@@ -1365,7 +1591,7 @@ void LLCDynamicStream::markElementReadyToIssue(uint64_t elementIdx) {
 
   // Increment the counter in the base stream.
   this->numElementsReadyToIssue++;
-  if (this->rootStream) {
+  if (this->rootStream && !this->isChainedIndirectLoad()) {
     this->rootStream->numIndirectElementsReadyToIssue++;
   }
 }
@@ -1399,7 +1625,7 @@ void LLCDynamicStream::markElementIssued(uint64_t elementIdx) {
          "Underflow NumElementsReadyToIssue.");
   this->numElementsReadyToIssue--;
   this->nextIssueElementIdx++;
-  if (this->rootStream) {
+  if (this->rootStream && !this->isChainedIndirectLoad()) {
     assert(this->rootStream->numIndirectElementsReadyToIssue > 0 &&
            "Underflow NumIndirectElementsReadyToIssue.");
     this->rootStream->numIndirectElementsReadyToIssue--;
@@ -8,6 +8,7 @@
 #include "mem/ruby/protocol/CoherenceRequestType.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
+#include <array>
 #include <deque>
 #include <list>
 #include <map>
@@ -46,12 +47,18 @@ struct LLCStreamRequest {
 
   // Optional for StreamForward request with smaller payload size.
   int payloadSize = RubySystem::getBlockSizeBytes();
+  // Optional for StreamForward request, the forwarded bytes in dataBlock.
+  int payloadLineOffset = 0;
+  int payloadDataSize = RubySystem::getBlockSizeBytes();
 
   // Optional for Multicast request, excluding the original stream
   std::vector<DynamicStreamSliceId> multicastSliceIds;
 
   // Optional for StreamForward request, the receiver stream id.
   DynamicStreamId forwardToStreamId;
+
+  // Optional for direct load request, the region hint for memory fetch.
+  int regionFetchLines = 0;
 };
 
 class LLCDynamicStream {
@@ -82,6 +89,25 @@ public:
     return this->isIndirect() && this->baseStream->isIndirect() &&
            this->getStaticStream()->isReduction();
   }
+  /**
+   * IndirectLoadStream based on another IndirectStream, e.g. A[] in
+   * A[B[C[i]]]. It is issued by the bank receiving the base element, instead
+   * of the bank of the root stream.
+   */
+  bool isChainedIndirectLoad() const {
+    return this->isIndirect() && this->baseStream->isIndirect() &&
+           this->getStaticStream()->isLoadStream();
+  }
+  bool isParallelReduction() const {
+    return this->configData->isParallelReduction;
+  }
+  /**
+   * Indirect and ParallelReductionStream charge the computation latency at
+   * each bank, but defer the real computation to be done in order.
+   */
+  bool isDeferredReduction() const {
+    return this->isIndirectReduction() || this->isParallelReduction();
+  }
   bool shouldRangeSync() const { return this->configData->rangeSync; }
   bool isPredicated() const { return this->configData->isPredicated; }
   bool isPredicatedTrue() const {
@@ -197,6 +223,7 @@ public:
   }
   static void allocateLLCStreams(AbstractStreamAwareController *mlcController,
                                  CacheStreamConfigureVec &configs);
+  static size_t getNumLLCStreams() { return GlobalLLCDynamicStreamMap.size(); }
 
   bool isBasedOn(const DynamicStreamId &baseId) const;
   void recvStreamForward(LLCStreamEngine *se, uint64_t baseElementIdx,
@@ -249,9 +276,28 @@ private:
   static LLCDynamicStreamPtr
   allocateLLCStream(AbstractStreamAwareController *mlcController,
                     CacheStreamConfigureDataPtr &config);
+  static void
+  allocateIndirectLLCStreams(AbstractStreamAwareController *mlcController,
+                             AbstractStreamAwareController *llcController,
+                             LLCDynamicStreamPtr baseS);
 
   Cycles curCycle() const;
   int curRemoteBank() const;
+
+  /**
+   * ParallelReduction combines the partial results along a binary tree over
+   * the banks, rooted at the bank nearest to the requesting MLC.
+   * The latency is charged on the path from the last bank done to the root,
+   * as all other partial results are already there.
+   */
+  int getParallelReductionRootBank() const;
+  Cycles getParallelReductionTreeLatency(int lastBank) const;
+
+  /**
+   * MergeStream buffers the keys of the two key streams, and walks them in
+   * order to reduce over the matched keys.
+   */
+  StreamValue computeMergeStreamElementValue(const LLCStreamElementPtr &element);
   const char *curRemoteMachineType() const;
 
   // This is really just used for memorizing in IndirectStream.
@@ -270,6 +316,12 @@ public:
   LLCStreamElementPtr lastReductionElement = nullptr;
   // Remember the last really computed indirect reduction element.
   uint64_t lastComputedReductionElementIdx = 0;
+  // LLC banks holding a partial result of the ParallelReduction.
+  std::set<int> parallelReductionBanks;
+  // Keys not yet consumed by the merge walk of MergeStream.
+  std::array<std::deque<StreamValue>, 2> mergeKeys;
+  // Latency of the last merge walk, charged in the compute path.
+  Cycles lastMergeLatency = Cycles(0);
 
   std::vector<CacheStreamConfigureDataPtr> sendToConfigs;
 
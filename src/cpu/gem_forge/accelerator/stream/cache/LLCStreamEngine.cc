@@ -16,8 +16,12 @@
 
 #include "cpu/gem_forge/accelerator/stream/stream_atomic_op.hh"
 #include "cpu/gem_forge/accelerator/stream/stream_engine.hh"
+#include "cpu/gem_forge/accelerator/stream/stream_event_tracer.hh"
 #include "cpu/gem_forge/llvm_trace_cpu.hh"
+#include "cpu/thread_context.hh"
+#include "sim/stream_nuca/stream_nuca_manager.hh"
 
+#include "base/host_profile.hh"
 #include "base/trace.hh"
 #include "debug/LLCRubyStreamBase.hh"
 #include "debug/LLCRubyStreamLife.hh"
@@ -685,8 +689,9 @@ bool LLCStreamEngine::canMigrateStream(LLCDynamicStream *stream) const {
       if (!IS->waitingPredicatedElements.empty()) {
         return false;
       }
-      if (IS->getStaticStream()->isReduction() ||
-          IS->getStaticStream()->isPointerChaseIndVar()) {
+      if ((IS->getStaticStream()->isReduction() ||
+           IS->getStaticStream()->isPointerChaseIndVar()) &&
+          !IS->isParallelReduction()) {
         // We wait for the reduction element to be done.
         if (!IS->idxToElementMap.empty()) {
           const auto &element = IS->idxToElementMap.begin()->second;
@@ -719,7 +724,10 @@ bool LLCStreamEngine::canMigrateStream(LLCDynamicStream *stream) const {
   return true;
 }
 
+HOST_PROFILE_COUNTER(hostProfileLLCSEWakeup, "stream.llc_se.wakeup");
+
 void LLCStreamEngine::wakeup() {
+  HOST_PROFILE_SCOPE(hostProfileLLCSEWakeup);
 
   // Sanity check.
   if (this->streams.size() >= 1000) {
@@ -765,6 +773,7 @@ void LLCStreamEngine::wakeup() {
       !this->requestQueue.empty() || !this->incomingStreamDataQueue.empty() ||
       !this->allocatedSlices.empty() || !this->readyComputations.empty() ||
       !this->inflyComputations.empty() ||
+      !this->chainedIndirectStreams.empty() ||
       this->commitController->hasStreamToCommit()) {
     this->scheduleEvent(Cycles(1));
   }
@@ -1169,12 +1178,14 @@ void LLCStreamEngine::issueStreams() {
     return;
   }
 
+  // Chained indirect streams are issued first, like other indirect streams.
+  auto issuedStreams = this->issueChainedIndirectStreams();
+
   // By cheching i < nStreams we avoid issuing the same stream more
   // than once.
   auto streamIter = this->streams.begin();
   auto streamEnd = this->streams.end();
   auto checkedStreams = 0;
-  auto issuedStreams = 0;
   auto nStreams = this->streams.size();
   for (; checkedStreams < nStreams && issuedStreams < this->issueWidth;
        ++checkedStreams) {
@@ -1210,6 +1221,11 @@ LLCStreamEngine::findStreamReadyToIssue(LLCDynamicStreamPtr dynS) {
   auto &statistic = S->statistic;
   statistic.sampleLLCAliveElements(dynS->idxToElementMap.size());
   statistic.sampleLLCInflyComputation(dynS->incompleteComputations);
+  if (this->isStreamNUCAMigrationCopying(S)) {
+    statistic.sampleLLCStreamEngineIssueReason(
+        StreamStatistic::LLCStreamEngineIssueReason::StreamNUCAMigrate);
+    return nullptr;
+  }
   /**
    * Prioritize indirect streams.
    */
@@ -1391,6 +1407,10 @@ LLCStreamEngine::findIndirectStreamReadyToIssue(LLCDynamicStreamPtr dynS) {
   LLCDynamicStreamPtr readyS = nullptr;
   uint64_t readyElementIdx = 0;
   for (auto dynIS : dynS->getAllIndStreams()) {
+    if (dynIS->isChainedIndirectLoad()) {
+      // Issued by the bank receiving the base element.
+      continue;
+    }
     auto IS = dynIS->getStaticStream();
     IS->statistic.sampleLLCAliveElements(dynIS->idxToElementMap.size());
     // Enforce the per stream maxInflyRequests constraint.
@@ -1458,6 +1478,9 @@ void LLCStreamEngine::issueStreamDirect(LLCDynamicStream *dynS) {
   // Get the next address.
   auto slice = this->allocateSlice(dynS);
   const auto &sliceId = slice->getSliceId();
+  StreamEventTracer::trace(StreamEventTracer::LLCIssue,
+                           dynS->getDynamicStreamId(), sliceId.getStartIdx(),
+                           this->curRemoteBank());
   Addr vaddr = sliceId.vaddr;
   auto machineType = dynS->getFloatMachineTypeAtElem(sliceId.getStartIdx());
   Addr paddr;
@@ -1488,6 +1511,11 @@ void LLCStreamEngine::issueStreamDirect(LLCDynamicStream *dynS) {
     }
     auto requestIter = this->enqueueRequest(S, sliceId, vaddrLine, paddrLine,
                                             this->myMachineType(), reqType);
+    if (reqType == CoherenceRequestType_GETH ||
+        reqType == CoherenceRequestType_GETU) {
+      requestIter->regionFetchLines =
+          this->getStreamRegionFetchLines(dynS, sliceId);
+    }
 
     if (S->isStoreStream()) {
       /**
@@ -1557,6 +1585,37 @@ void LLCStreamEngine::issueStreamDirect(LLCDynamicStream *dynS) {
   dynS->updateIssueClearCycle();
 }
 
+int LLCStreamEngine::getStreamRegionFetchLines(
+    LLCDynamicStream *dynS, const DynamicStreamSliceId &sliceId) const {
+  if (!this->controller->isStreamRegionFetchEnabled()) {
+    return 0;
+  }
+  auto linearAddrGen = std::dynamic_pointer_cast<LinearAddrGenCallback>(
+      dynS->configData->addrGenCallback);
+  if (!linearAddrGen) {
+    return 0;
+  }
+  auto elementSize = dynS->getMemElementSize();
+  if (!linearAddrGen->isContinuous(dynS->configData->addrGenFormalParams,
+                                   elementSize)) {
+    return 0;
+  }
+  int64_t lines = this->controller->getStreamRegionFetchLines();
+  if (dynS->hasTotalTripCount()) {
+    // Do not fetch beyond the end of the stream.
+    int64_t remainElements =
+        dynS->getTotalTripCount() - static_cast<int64_t>(sliceId.getEndIdx());
+    if (remainElements <= 0) {
+      return 0;
+    }
+    int64_t blockSize = RubySystem::getBlockSizeBytes();
+    int64_t remainLines =
+        (remainElements * elementSize + blockSize - 1) / blockSize;
+    lines = std::min(lines, remainLines + 1);
+  }
+  return lines > 1 ? lines : 0;
+}
+
 CoherenceRequestType
 LLCStreamEngine::getDirectStreamReqType(LLCDynamicStream *stream) const {
   auto reqType = CoherenceRequestType_GETH;
@@ -1610,6 +1669,77 @@ void LLCStreamEngine::issueStreamIndirect(LLCDynamicStream *dynIS) {
   dynIS->markElementIssued(elementIdx);
 }
 
+void LLCStreamEngine::pushChainedIndirectStream(LLCDynamicStream *dynIS) {
+  /**
+   * Instead of sending the value back to the bank of the root stream, the
+   * request is directly forwarded to the bank owning the next address.
+   * Elements are still issued in order, so the last bank receiving the base
+   * element issues the pending ones.
+   *
+   * NOTE: This is a modelling approximation. A chained element is issued
+   * NOTE: from whichever bank completes the in-order prefix, not
+   * NOTE: necessarily the bank that received its own base element.
+   */
+  const auto &dynId = dynIS->getDynamicStreamId();
+  for (const auto &chainedId : this->chainedIndirectStreams) {
+    if (chainedId == dynId) {
+      return;
+    }
+  }
+  this->chainedIndirectStreams.push_back(dynId);
+  this->scheduleEvent(Cycles(1));
+}
+
+int LLCStreamEngine::issueChainedIndirectStreams() {
+  if (this->chainedIndirectStreams.empty()) {
+    return 0;
+  }
+  this->initializeTranslationBuffer();
+  int issuedStreams = 0;
+  // Check each stream at most once, as issued ones are moved to the end.
+  auto nStreams = this->chainedIndirectStreams.size();
+  auto iter = this->chainedIndirectStreams.begin();
+  for (size_t checkedStreams = 0;
+       checkedStreams < nStreams && issuedStreams < this->issueWidth;
+       ++checkedStreams) {
+    auto dynIS = LLCDynamicStream::getLLCStream(*iter);
+    if (!dynIS || !dynIS->getFirstReadyToIssueElement()) {
+      // Released or nothing more to issue from this bank.
+      iter = this->chainedIndirectStreams.erase(iter);
+      continue;
+    }
+    auto IS = dynIS->getStaticStream();
+    if (dynIS->inflyRequests == dynIS->getMaxInflyRequests()) {
+      LLC_S_DPRINTF_(LLCRubyStreamNotIssue, dynIS->getDynamicStreamId(),
+                     "[NotIssue] MaxInflyRequests %d.\n",
+                     dynIS->getMaxInflyRequests());
+      IS->statistic.sampleLLCStreamEngineIssueReason(
+          StreamStatistic::LLCStreamEngineIssueReason::MaxInflyRequest);
+      ++iter;
+      continue;
+    }
+    if (this->isStreamNUCAMigrationCopying(IS)) {
+      IS->statistic.sampleLLCStreamEngineIssueReason(
+          StreamStatistic::LLCStreamEngineIssueReason::StreamNUCAMigrate);
+      ++iter;
+      continue;
+    }
+    LLC_S_DPRINTF(dynIS->getDynamicStreamId(),
+                  "[ChainedIndirect] Issue element %llu.\n",
+                  dynIS->getFirstReadyToIssueElement()->idx);
+    IS->statistic.sampleLLCStreamEngineIssueReason(
+        StreamStatistic::LLCStreamEngineIssueReason::IndirectPriority);
+    this->issueStreamIndirect(dynIS);
+    issuedStreams++;
+    // Round robin among chained streams.
+    auto issuedIter = iter++;
+    this->chainedIndirectStreams.splice(this->chainedIndirectStreams.end(),
+                                        this->chainedIndirectStreams,
+                                        issuedIter);
+  }
+  return issuedStreams;
+}
+
 void LLCStreamEngine::generateIndirectStreamRequest(
     LLCDynamicStream *dynIS, LLCStreamElementPtr element) {
 
@@ -1620,6 +1750,11 @@ void LLCStreamEngine::generateIndirectStreamRequest(
     return;
   }
 
+  this->sampleStreamNUCAIndirectAccess(dynIS, element);
+  StreamEventTracer::trace(StreamEventTracer::LLCIssue,
+                           dynIS->getDynamicStreamId(), element->idx,
+                           this->curRemoteBank());
+
   if (IS->isStoreComputeStream() || IS->isAtomicComputeStream()) {
     this->issueIndirectStoreOrAtomicRequest(dynIS, element);
     return;
@@ -1632,6 +1767,39 @@ void LLCStreamEngine::generateIndirectStreamRequest(
   return;
 }
 
+StreamNUCAManager *LLCStreamEngine::getStreamNUCAManager(Stream *S) {
+  // Streams from different processes may share this bank.
+  auto tc = S->getCPUDelegator()->getSingleThreadContext();
+  return tc->getStreamNUCAManager().get();
+}
+
+void LLCStreamEngine::sampleStreamNUCAIndirectAccess(
+    LLCDynamicStream *dynIS, const LLCStreamElementPtr &element) {
+  auto IS = dynIS->getStaticStream();
+  auto manager = this->getStreamNUCAManager(IS);
+  if (!manager->isOnlineMigrationEnabled() || !dynIS->baseStream) {
+    return;
+  }
+  Addr paddr;
+  if (!dynIS->translateToPAddr(element->vaddr, paddr)) {
+    return;
+  }
+  const auto &baseDynStreamId = dynIS->baseStream->getDynamicStreamId();
+  for (const auto &baseElement : element->baseElements) {
+    if (baseElement->dynStreamId == baseDynStreamId) {
+      auto targetBank =
+          this->controller->mapAddressToLLCOrMem(paddr, MachineType_L2Cache)
+              .getNum();
+      manager->sampleIndirectAccess(baseElement->vaddr, targetBank);
+      break;
+    }
+  }
+}
+
+bool LLCStreamEngine::isStreamNUCAMigrationCopying(Stream *S) {
+  return this->getStreamNUCAManager(S)->isOnlineMigrationCopying();
+}
+
 void LLCStreamEngine::issueIndirectLoadRequest(LLCDynamicStream *dynIS,
                                                LLCStreamElementPtr element) {
   /**
@@ -2002,6 +2170,9 @@ void LLCStreamEngine::issueStreamRequestToRemoteBank(
   msg->m_Destination.add(destMachineId);
   msg->m_MessageSize = MessageSizeType_Control;
   msg->m_sliceIds.add(sliceId);
+  if (destMachineType == MachineType::MachineType_L2Cache) {
+    msg->m_Len = req.regionFetchLines;
+  }
 
   // We need to set hold the store value.
   if (req.requestType == CoherenceRequestType_STREAM_STORE) {
@@ -2016,7 +2187,10 @@ void LLCStreamEngine::issueStreamRequestToRemoteBank(
     /**
      * We model special size for StreamForward request.
      */
-    msg->m_MessageSize = this->controller->getMessageSizeType(req.payloadSize);
+    msg->m_MessageSize = this->getStreamDataMessageSizeType(
+        sliceId,
+        req.dataBlock.getData(req.payloadLineOffset, req.payloadDataSize),
+        req.payloadDataSize, req.payloadSize, req.payloadLineOffset);
   }
 
   if (Debug::LLCRubyStreamMulticast && !req.multicastSliceIds.empty()) {
@@ -2097,12 +2271,31 @@ LLCStreamEngine::ResponseMsgPtr LLCStreamEngine::createStreamMsgToMLC(
   if (data) {
     assert(lineOffset + dataSize <= RubySystem::getBlockSizeBytes());
     msg->m_DataBlk.setData(data, lineOffset, dataSize);
-    msg->m_MessageSize = this->controller->getMessageSizeType(payloadSize);
+    msg->m_MessageSize = this->getStreamDataMessageSizeType(
+        sliceId, data, dataSize, payloadSize, lineOffset);
   }
   return msg;
 }
 
-void LLCStreamEngine::issueStreamMsgToMLC(ResponseMsgPtr msg, bool forceIdea) {
+MessageSizeType LLCStreamEngine::getStreamDataMessageSizeType(
+    const DynamicStreamSliceId &sliceId, const uint8_t *data, int dataSize,
+    int payloadSize, int lineOffset) {
+  if (!this->controller->isStreamCompressEnabled()) {
+    return this->controller->getMessageSizeType(payloadSize);
+  }
+  auto compressedSize = this->controller->compressStreamData(
+      data, lineOffset, dataSize, payloadSize);
+  if (auto dynS = LLCDynamicStream::getLLCStream(sliceId.getDynStreamId())) {
+    dynS->getStaticStream()->statistic.sampleLLCCompressedData(payloadSize,
+                                                               compressedSize);
+  }
+  LLC_SLICE_DPRINTF(sliceId, "Compress stream data %d -> %d bytes.\n",
+                    payloadSize, compressedSize);
+  return this->controller->getCompressedMessageSizeType(compressedSize);
+}
+
+void LLCStreamEngine::issueStreamMsgToMLC(ResponseMsgPtr msg, bool forceIdea,
+                                          Cycles extraLatency) {
 
   auto mlcMachineId = msg->m_Destination.singleElement();
   const auto &sliceId = msg->m_sliceIds.singleSliceId();
@@ -2120,7 +2313,7 @@ void LLCStreamEngine::issueStreamMsgToMLC(ResponseMsgPtr msg, bool forceIdea) {
      * This should match with LLC controller l2_response_latency.
      * TODO: Really get this value from the controller.
      */
-    Cycles latency(2);
+    Cycles latency = Cycles(2) + extraLatency;
     this->streamResponseMsgBuffer->enqueue(
         msg, this->controller->clockEdge(),
         this->controller->cyclesToTicks(latency));
@@ -2195,11 +2388,37 @@ void LLCStreamEngine::issueStreamRangeToMLC(DynamicStreamAddressRangePtr &range,
 void LLCStreamEngine::issueStreamDataToMLC(const DynamicStreamSliceId &sliceId,
                                            Addr paddrLine, const uint8_t *data,
                                            int dataSize, int payloadSize,
-                                           int lineOffset, bool forceIdea) {
+                                           int lineOffset, bool forceIdea,
+                                           Cycles extraLatency) {
   auto msg = this->createStreamMsgToMLC(
       sliceId, CoherenceResponseType_DATA_EXCLUSIVE, paddrLine, data, dataSize,
       payloadSize, lineOffset);
-  this->issueStreamMsgToMLC(msg, forceIdea);
+  this->issueStreamMsgToMLC(msg, forceIdea, extraLatency);
+  this->recordFloatFeedbackHops(sliceId);
+}
+
+void LLCStreamEngine::recordFloatFeedbackHops(
+    const DynamicStreamSliceId &sliceId) {
+  auto dynS = LLCDynamicStream::getLLCStream(sliceId.getDynStreamId());
+  if (!dynS) {
+    return;
+  }
+  auto S = dynS->getStaticStream();
+  if (!S->se->isAdaptiveFloatEnabled()) {
+    return;
+  }
+  auto dynCoreS = S->getDynamicStream(sliceId.getDynStreamId());
+  if (!dynCoreS) {
+    // The core stream is already released.
+    return;
+  }
+  int myBank = this->controller->getMachineID().getNum();
+  int mlcBank = sliceId.getDynStreamId().coreId;
+  int cols = this->controller->getNumCols();
+  auto &feedback = dynCoreS->floatFeedback;
+  feedback.numHopSlices++;
+  feedback.numHops += std::abs(myBank / cols - mlcBank / cols) +
+                      std::abs(myBank % cols - mlcBank % cols);
 }
 
 void LLCStreamEngine::issueStreamDataToLLC(
@@ -2247,7 +2466,30 @@ void LLCStreamEngine::issueStreamDataToLLC(
     // Remember the receiver dynamic id and forwarded data block.
     reqIter->forwardToStreamId = recvConfig->dynamicId;
     reqIter->dataBlock = dataBlock;
+    /**
+     * Only the bytes of the sender elements within the line are forwarded.
+     */
+    auto blockBytes = RubySystem::getBlockSizeBytes();
+    auto sliceVAddrLine = makeLineAddress(sliceId.vaddr);
+    int payloadLHS = blockBytes;
+    int payloadRHS = 0;
+    for (auto idx = sliceId.getStartIdx(); idx < sliceId.getEndIdx(); ++idx) {
+      auto element = stream->getElementPanic(idx, "IssueStreamDataToLLC");
+      int lineOffset;
+      int elementOffset;
+      int overlapSize = element->computeOverlap(sliceVAddrLine, blockBytes,
+                                                lineOffset, elementOffset);
+      payloadLHS = std::min(payloadLHS, lineOffset);
+      payloadRHS = std::max(payloadRHS, lineOffset + overlapSize);
+    }
+    assert(payloadLHS < payloadRHS && "Empty StreamForward payload.");
+    reqIter->payloadLineOffset = payloadLHS;
+    reqIter->payloadDataSize = payloadRHS - payloadLHS;
     reqIter->payloadSize = payloadSize;
+    if (this->controller->isStreamCompressEnabled()) {
+      // We only compress the forwarded range, so it bounds the payload.
+      reqIter->payloadSize = std::min(payloadSize, payloadRHS - payloadLHS);
+    }
   } else {
     LLC_SLICE_PANIC(sliceId, "Translation fault on the ReceiverStream: %s.",
                     recvConfig->dynamicId);
@@ -2696,13 +2938,14 @@ void LLCStreamEngine::triggerIndirectElement(LLCDynamicStreamPtr stream,
     assert(!IS->isPredicated() && "Disable predication for now.");
     // Not predicated, add to readyElements.
     if (stream->baseStream) {
-      // The only type of two-level indirection is
-      // Reduction/StoreCompute.
+      // The only types of multi-level indirection are
+      // Reduction/StoreCompute/ChainedLoad.
       auto ISS = IS->getStaticStream();
-      if (!ISS->isReduction() && !ISS->isStoreComputeStream()) {
+      if (!ISS->isReduction() && !ISS->isStoreComputeStream() &&
+          !IS->isChainedIndirectLoad()) {
         LLC_S_PANIC(IS->getDynamicStreamId(),
-                    "Does not support Two-Level Indirection other than "
-                    "Reduction/StoreCompute.");
+                    "Does not support Multi-Level Indirection other than "
+                    "Reduction/StoreCompute/ChainedLoad.");
       }
     }
     LLC_S_DPRINTF(IS->getDynamicStreamId(),
@@ -2716,6 +2959,9 @@ void LLCStreamEngine::triggerIndirectElement(LLCDynamicStreamPtr stream,
         this->pushReadyComputation(indirectElement);
       } else {
         IS->markElementReadyToIssue(indirectElementIdx);
+        if (IS->isChainedIndirectLoad()) {
+          this->pushChainedIndirectStream(IS);
+        }
       }
     } else {
       for (const auto &baseE : indirectElement->baseElements) {
@@ -3656,9 +3902,10 @@ void LLCStreamEngine::pushInflyComputation(LLCStreamElementPtr &element,
       this->controller->myParams->llc_stream_engine_max_infly_computation;
   assert(this->inflyComputations.size() < maxInflyComputation &&
          "Too many infly results.");
-  assert(latency < 1024 && "Latency too long.");
-
   auto S = element->S;
+  assert((latency <= MaxInflyComputationLatency || S->isMergeStream()) &&
+         "Latency too long.");
+
   // For now we don't bother add the stats to the core in my bank.
   S->recordComputationInCoreStats();
 
@@ -3672,16 +3919,27 @@ void LLCStreamEngine::pushInflyComputation(LLCStreamElementPtr &element,
   statistic.numLLCComputationWaitLatency +=
       this->curCycle() - element->getComputationScheduledCycle();
 
-  Cycles readyCycle = this->curCycle() + latency;
+  this->insertInflyComputation(element, result, latency);
+}
+
+void LLCStreamEngine::insertInflyComputation(const LLCStreamElementPtr &element,
+                                             const StreamValue &result,
+                                             Cycles latency) {
+  Cycles roundLatency =
+      std::min(latency, Cycles(MaxInflyComputationLatency));
+  Cycles remainLatency = latency - roundLatency;
+  Cycles readyCycle = this->curCycle() + roundLatency;
   for (auto iter = this->inflyComputations.rbegin(),
             end = this->inflyComputations.rend();
        iter != end; ++iter) {
     if (iter->readyCycle <= readyCycle) {
-      this->inflyComputations.emplace(iter.base(), element, result, readyCycle);
+      this->inflyComputations.emplace(iter.base(), element, result, readyCycle,
+                                      remainLatency);
       return;
     }
   }
-  this->inflyComputations.emplace_front(element, result, readyCycle);
+  this->inflyComputations.emplace_front(element, result, readyCycle,
+                                        remainLatency);
 }
 
 void LLCStreamEngine::recordComputationMicroOps(Stream *S) {
@@ -3745,7 +4003,7 @@ void LLCStreamEngine::startComputation() {
       latency = Cycles(0);
     }
     /**
-     * For IndirectReductionStream, we separate out charging the
+     * For Indirect/ParallelReductionStream, we separate out charging the
      * latency from the real computation. Here we charge the latency,
      * but the real computation is left in completeComputation().
      */
@@ -3773,15 +4031,24 @@ void LLCStreamEngine::startComputation() {
         continue;
       }
 
-      if (!dynS->isIndirectReduction()) {
+      if (!dynS->isDeferredReduction()) {
         LLC_ELEMENT_DPRINTF(element,
                             "Start computation. Latency %llu (ZeroLat %d).\n",
                             latency, forceZeroLat);
         result = dynS->computeStreamElementValue(element);
+        if (S->isMergeStream() && !forceZeroLat) {
+          /**
+           * MergeStream charges the comparisons of its merge walk. Draining
+           * the last element may walk many keys, which is charged in
+           * multiple rounds.
+           */
+          latency = dynS->lastMergeLatency;
+          LLC_ELEMENT_DPRINTF(element, "Merge latency %llu.\n", latency);
+        }
       } else {
         LLC_ELEMENT_DPRINTF(element,
-                            "Start IndirectReduction fake computation. Latency "
-                            "%llu (ZeroLat %d).\n",
+                            "Start Indirect/ParallelReduction fake "
+                            "computation. Latency %llu (ZeroLat %d).\n",
                             latency, forceZeroLat);
         result.fill(0);
       }
@@ -3806,6 +4073,17 @@ void LLCStreamEngine::completeComputation() {
                           computation.readyCycle, curCycle);
       break;
     }
+    if (computation.remainLatency > 0) {
+      // Charge the next round.
+      auto continueElement = element;
+      auto result = computation.result;
+      auto remainLatency = computation.remainLatency;
+      LLC_ELEMENT_DPRINTF(element, "Continue computation. Remain %llu.\n",
+                          remainLatency);
+      this->inflyComputations.pop_front();
+      this->insertInflyComputation(continueElement, result, remainLatency);
+      continue;
+    }
     LLC_ELEMENT_DPRINTF(element, "Complete computation.\n");
     if (element->isNDCElement) {
       this->ndcController->completeComputation(element, computation.result);
@@ -27,6 +27,7 @@ class LLCStreamMigrationController;
 class LLCStreamNDCController;
 class LLCStreamAtomicLockManager;
 class StreamRequestBuffer;
+class StreamNUCAManager;
 
 class LLCStreamEngine : public Consumer {
 public:
@@ -219,6 +220,16 @@ private:
   LLCDynamicStreamPtr findStreamReadyToIssue(LLCDynamicStreamPtr dynS);
   LLCDynamicStreamPtr findIndirectStreamReadyToIssue(LLCDynamicStreamPtr dynS);
 
+  /**
+   * StreamNUCA online migration support.
+   * Sample the bank of indirect requests, and stall issuing while the
+   * migrated pages are being copied.
+   */
+  StreamNUCAManager *getStreamNUCAManager(Stream *S);
+  void sampleStreamNUCAIndirectAccess(LLCDynamicStream *dynIS,
+                                      const LLCStreamElementPtr &element);
+  bool isStreamNUCAMigrationCopying(Stream *S);
+
   /**
    * Issue a DirectStream.
    */
@@ -229,11 +240,29 @@ private:
    */
   void issueStreamIndirect(LLCDynamicStream *dynIS);
 
+  /**
+   * Chained indirect streams with elements ready to issue from this bank,
+   * which received their base elements. They share the issue width and
+   * the per stream MaxInflyRequests with other streams.
+   * Remember the DynamicStreamId as the stream may be released.
+   */
+  std::list<DynamicStreamId> chainedIndirectStreams;
+  void pushChainedIndirectStream(LLCDynamicStream *dynIS);
+  int issueChainedIndirectStreams();
+
   /**
    * Get the request type for this stream.
    */
   CoherenceRequestType getDirectStreamReqType(LLCDynamicStream *stream) const;
 
+  /**
+   * Get the number of lines to ask the L2 to fetch as a region from memory
+   * if this request misses. Only for continuous affine streams.
+   * 0 means no region fetch.
+   */
+  int getStreamRegionFetchLines(LLCDynamicStream *dynS,
+                                const DynamicStreamSliceId &sliceId) const;
+
   /**
    * Generate indirect stream request.
    */
@@ -287,7 +316,17 @@ private:
                                       Addr paddrLine, const uint8_t *data,
                                       int dataSize, int payloadSize,
                                       int lineOffset);
-  void issueStreamMsgToMLC(ResponseMsgPtr msg, bool forceIdea = false);
+  void issueStreamMsgToMLC(ResponseMsgPtr msg, bool forceIdea = false,
+                           Cycles extraLatency = Cycles(0));
+
+  /**
+   * Get the message size of the stream data. If the controller has a
+   * stream compressor, the payload is sized by its compressed size and
+   * the compression ratio is recorded in the stream statistic.
+   */
+  MessageSizeType getStreamDataMessageSizeType(
+      const DynamicStreamSliceId &sliceId, const uint8_t *data, int dataSize,
+      int payloadSize, int lineOffset);
 
   /**
    * Helper function to issue stream ack back to MLC at request core.
@@ -318,7 +357,12 @@ private:
    */
   void issueStreamDataToMLC(const DynamicStreamSliceId &sliceId, Addr paddrLine,
                             const uint8_t *data, int dataSize, int payloadSize,
-                            int lineOffset, bool forceIdea = false);
+                            int lineOffset, bool forceIdea = false,
+                            Cycles extraLatency = Cycles(0));
+  /**
+   * Record the hops to the MLC as the adaptive float feedback.
+   */
+  void recordFloatFeedbackHops(const DynamicStreamSliceId &sliceId);
 
   /**
    * Send the stream data to streams another LLC bank. Used for SendTo edge.
@@ -462,18 +506,29 @@ private:
    * (e.g. Reduction).
    */
   std::list<LLCStreamElementPtr> readyComputations;
+  /**
+   * Each infly computation charges at most this latency. Longer latency,
+   * e.g. the merge walk of MergeStream, is split into multiple rounds and
+   * the element is only completed after the last round.
+   */
+  static constexpr uint64_t MaxInflyComputationLatency = 1023;
   struct InflyComputation {
     LLCStreamElementPtr element;
     StreamValue result;
     Cycles readyCycle;
+    Cycles remainLatency;
     InflyComputation(const LLCStreamElementPtr &_element,
-                     const StreamValue &_result, Cycles _readyCycle)
-        : element(_element), result(_result), readyCycle(_readyCycle) {}
+                     const StreamValue &_result, Cycles _readyCycle,
+                     Cycles _remainLatency)
+        : element(_element), result(_result), readyCycle(_readyCycle),
+          remainLatency(_remainLatency) {}
   };
   std::list<InflyComputation> inflyComputations;
   void pushReadyComputation(LLCStreamElementPtr &element);
   void pushInflyComputation(LLCStreamElementPtr &element,
                             const StreamValue &result, Cycles &latency);
+  void insertInflyComputation(const LLCStreamElementPtr &element,
+                              const StreamValue &result, Cycles latency);
   void recordComputationMicroOps(Stream *S);
   void startComputation();
   void completeComputation();
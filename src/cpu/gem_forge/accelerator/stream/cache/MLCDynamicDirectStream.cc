@@ -2,6 +2,7 @@
 #include "LLCStreamEngine.hh"
 #include "MLCDynamicIndirectStream.hh"
 #include "cpu/gem_forge/accelerator/stream/stream.hh"
+#include "cpu/gem_forge/accelerator/stream/stream_event_tracer.hh"
 
 // Generated by slicc.
 #include "mem/ruby/protocol/CoherenceMsg.hh"
@@ -473,6 +474,9 @@ void MLCDynamicDirectStream::receiveStreamData(
   assert(this->dynamicStreamId == sliceId.getDynStreamId() &&
          "Unmatched dynamic stream id.");
   MLC_SLICE_DPRINTF(sliceId, "Receive data %#x.\n", sliceId.vaddr);
+  StreamEventTracer::trace(StreamEventTracer::MLCReceive,
+                           this->getDynamicStreamId(), sliceId.getStartIdx(),
+                           this->controller->getMachineID().num);
 
   /**
    * It is possible when the core stream engine runs ahead than
@@ -1,5 +1,7 @@
 #include "MLCDynamicIndirectStream.hh"
 
+#include "cpu/gem_forge/accelerator/stream/stream_event_tracer.hh"
+
 #include "mem/ruby/slicc_interface/AbstractStreamAwareController.hh"
 
 #include "base/trace.hh"
@@ -35,6 +37,9 @@ void MLCDynamicIndirectStream::receiveStreamData(
 
   MLC_SLICE_DPRINTF(sliceId, "Receive data vaddr %#x paddr %#x.\n",
                     sliceId.vaddr, paddrLine);
+  StreamEventTracer::trace(StreamEventTracer::MLCReceive,
+                           this->getDynamicStreamId(), sliceId.getStartIdx(),
+                           this->controller->getMachineID().num);
 
   // Intercept the reduction value.
   if (this->receiveFinalReductionValue(sliceId, dataBlock, paddrLine)) {
@@ -9,11 +9,14 @@
 #include "mem/ruby/slicc_interface/AbstractStreamAwareController.hh"
 
 #include "cpu/gem_forge/accelerator/stream/stream_engine.hh"
+#include "cpu/gem_forge/accelerator/stream/stream_event_tracer.hh"
 
 #include "base/trace.hh"
 #include "debug/MLCRubyStreamBase.hh"
 #include "debug/StreamRangeSync.hh"
 
+#include <cstdlib>
+
 #define DEBUG_TYPE MLCRubyStreamBase
 #include "../stream_log.hh"
 
@@ -54,6 +57,10 @@ MLCDynamicStream::MLCDynamicStream(CacheStreamConfigureDataPtr _configData,
                  "Wait %s. %s RangeSync.\n", this->to_string(this->isWaiting),
                  this->shouldRangeSync() ? "Enabled" : "Disabled");
 
+  StreamEventTracer::trace(StreamEventTracer::MLCConfig,
+                           this->getDynamicStreamId(), 0,
+                           this->controller->getMachineID().num);
+
   // Schedule the first advanceStreamEvent.
   this->stream->getCPUDelegator()->schedule(&this->advanceStreamEvent,
                                             Cycles(1));
@@ -114,6 +121,9 @@ MLCDynamicStream::WaitType MLCDynamicStream::checkWaiting() const {
 }
 
 void MLCDynamicStream::endStream() {
+  StreamEventTracer::trace(StreamEventTracer::MLCEnd,
+                           this->getDynamicStreamId(), this->tailSliceIdx,
+                           this->controller->getMachineID().num);
   MLC_S_DPRINTF(this->getDynamicStreamId(), "Ended with # slices %d.\n",
                 this->slices.size());
   for (auto &slice : this->slices) {
@@ -460,7 +470,7 @@ void MLCDynamicStream::makeAck(MLCStreamSlice &slice) {
         }
       }
       MLC_SLICE_DPRINTF(slice.sliceId, "Ack for element %llu.\n", elementIdx);
-      dynS->cacheAckedElements.insert(elementIdx);
+      dynS->cacheAckElement(elementIdx);
     }
   }
 }
@@ -88,43 +88,8 @@ void MLCStreamEngine::configureStream(
    * data.
    */
   std::vector<MLCDynamicIndirectStream *> indirectStreams;
-  for (const auto &edge : streamConfigureData->depEdges) {
-    if (edge.type == CacheStreamConfigureData::DepEdge::Type::UsedBy) {
-      const auto &indirectStreamConfig = edge.data;
-      // Let's create an indirect stream.
-      auto indirectStream = new MLCDynamicIndirectStream(
-          indirectStreamConfig, this->controller,
-          this->responseToUpperMsgBuffer, this->requestToLLCMsgBuffer,
-          streamConfigureData->dynamicId /* Root dynamic stream id. */);
-      this->idToStreamMap.emplace(indirectStream->getDynamicStreamId(),
-                                  indirectStream);
-      indirectStreams.push_back(indirectStream);
-
-      for (const auto &ISDepEdge : indirectStreamConfig->depEdges) {
-        if (ISDepEdge.type != CacheStreamConfigureData::DepEdge::UsedBy) {
-          continue;
-        }
-        /**
-         * So far we don't support Two-Level Indirect LLCStream, except:
-         * 1. IndirectRedcutionStream.
-         * 2. Two-Level IndirectStoreComputeStream.
-         */
-        auto ISDepS = ISDepEdge.data->stream;
-        if (ISDepS->isReduction() || ISDepS->isStoreComputeStream()) {
-          auto IIS = new MLCDynamicIndirectStream(
-              ISDepEdge.data, this->controller, this->responseToUpperMsgBuffer,
-              this->requestToLLCMsgBuffer,
-              streamConfigureData->dynamicId /* Root dynamic stream id. */);
-          this->idToStreamMap.emplace(IIS->getDynamicStreamId(), IIS);
-
-          indirectStreams.push_back(IIS);
-          continue;
-        }
-        panic("Two-Level Indirect LLCStream is not supported: %s.",
-              ISDepEdge.data->dynamicId);
-      }
-    }
-  }
+  this->createIndirectStreams(streamConfigureData,
+                              streamConfigureData->dynamicId, indirectStreams);
   // Create the direct stream.
   auto directStream = new MLCDynamicDirectStream(
       streamConfigureData, this->controller, this->responseToUpperMsgBuffer,
@@ -157,6 +122,42 @@ void MLCStreamEngine::configureStream(
   this->sendConfigToRemoteSE(streamConfigureData, masterId);
 }
 
+void MLCStreamEngine::createIndirectStreams(
+    const CacheStreamConfigureDataPtr &baseConfig,
+    const DynamicStreamId &rootDynamicId,
+    std::vector<MLCDynamicIndirectStream *> &indirectStreams) {
+  bool isBaseIndirect = baseConfig->dynamicId != rootDynamicId;
+  for (const auto &edge : baseConfig->depEdges) {
+    if (edge.type != CacheStreamConfigureData::DepEdge::Type::UsedBy) {
+      continue;
+    }
+    const auto &indirectStreamConfig = edge.data;
+    if (isBaseIndirect) {
+      /**
+       * Multi-Level Indirect LLCStream is limited to:
+       * 1. IndirectRedcutionStream.
+       * 2. Two-Level IndirectStoreComputeStream.
+       * 3. Chained IndirectLoadStream.
+       */
+      auto ISDepS = indirectStreamConfig->stream;
+      if (!ISDepS->isReduction() && !ISDepS->isStoreComputeStream() &&
+          !ISDepS->isLoadStream()) {
+        panic("Multi-Level Indirect LLCStream is not supported: %s.",
+              indirectStreamConfig->dynamicId);
+      }
+    }
+    // Let's create an indirect stream.
+    auto indirectStream = new MLCDynamicIndirectStream(
+        indirectStreamConfig, this->controller, this->responseToUpperMsgBuffer,
+        this->requestToLLCMsgBuffer, rootDynamicId);
+    this->idToStreamMap.emplace(indirectStream->getDynamicStreamId(),
+                                indirectStream);
+    indirectStreams.push_back(indirectStream);
+    this->createIndirectStreams(indirectStreamConfig, rootDynamicId,
+                                indirectStreams);
+  }
+}
+
 void MLCStreamEngine::sendConfigToRemoteSE(
     CacheStreamConfigureDataPtr streamConfigureData, MasterID masterId) {
 
@@ -393,7 +394,7 @@ void MLCStreamEngine::receiveStreamDataForSingleSlice(
           MLC_SLICE_DPRINTF(
               sliceId,
               "HACK! Directly Ack for Two-Level Indirect StoreComputeStream.");
-          dynCoreS->cacheAckedElements.insert(sliceId.getStartIdx());
+          dynCoreS->cacheAckElement(sliceId.getStartIdx());
           return;
         }
       }
@@ -137,6 +137,14 @@ private:
   friend class MLCStreamNDCController;
   std::unique_ptr<MLCStreamNDCController> ndcController;
 
+  /**
+   * Create the MLCDynamicIndirectStreams of all levels, in order.
+   */
+  void createIndirectStreams(
+      const CacheStreamConfigureDataPtr &baseConfig,
+      const DynamicStreamId &rootDynamicId,
+      std::vector<MLCDynamicIndirectStream *> &indirectStreams);
+
   /**
    * Send configure/end message to remote SE.
    */
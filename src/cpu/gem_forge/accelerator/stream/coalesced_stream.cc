@@ -114,6 +114,7 @@ void Stream::selectPrimeLogicalStream() {
     CHECK_INFO(panic, core_need_final_value);
     CHECK_INFO(panic, compute_info().value_base_streams_size);
     CHECK_INFO(panic, compute_info().enabled_store_func);
+    CHECK_INFO(panic, vector_lanes);
 #undef CHECK_INFO
     /**
      * Check if any LogicalStream has core user.
@@ -142,6 +143,24 @@ void Stream::selectPrimeLogicalStream() {
       assert(matched && "Failed to match MergedLoadStoreBaseStream.");
     }
   }
+
+  /**
+   * Vector streams are never coalesced (see StreamEngine), and the whole
+   * vector element is returned to the core user as one value.
+   */
+  if (this->getVectorLanes() > 1) {
+    if (this->logicals.size() != 1) {
+      S_PANIC(this, "Coalesced vector stream.");
+    }
+    if (this->getStreamType() == ::LLVM::TDG::StreamInfo_Type_IV) {
+      S_PANIC(this, "Vector IV stream is not supported.");
+    }
+    if (this->getCoreElementSize() > sizeof(StreamValue)) {
+      S_PANIC(this, "VectorLanes %d CoreElementSize %d > %d.",
+              this->getVectorLanes(), this->getCoreElementSize(),
+              sizeof(StreamValue));
+    }
+  }
 }
 
 void Stream::initializeBaseStreams() {
@@ -2,6 +2,7 @@
 #include "stream.hh"
 #include "stream_element.hh"
 #include "stream_engine.hh"
+#include "stream_float_controller.hh"
 
 #include "debug/StreamAlias.hh"
 #include "debug/StreamBase.hh"
@@ -178,6 +179,11 @@ void DynamicStream::configureAddrBaseDynStreamReuseOuterLoop(
   edge.reuseBaseElement = reuse;
 }
 
+void DynamicStream::cacheAckElement(uint64_t elementIdx) {
+  this->cacheAckedElements.insert(elementIdx);
+  this->stream->getCPUDelegator()->wakeupGemForgeInsts();
+}
+
 bool DynamicStream::areNextBaseElementsAllocated() const {
   return this->areNextAddrBaseElementsAllocated() &&
          this->areNextBackBaseElementsAllocated() &&
@@ -775,6 +781,9 @@ StreamElement *DynamicStream::releaseElementStepped(bool isEnd) {
   statistic.numStepped++;
   if (used) {
     statistic.numUsed++;
+    if (releaseElement->isElemFloatedToCache()) {
+      this->floatFeedback.numElements++;
+    }
     /**
      * Since this element is used by the core, we update the statistic
      * of the latency of this element experienced by the core.
@@ -793,6 +802,10 @@ StreamElement *DynamicStream::releaseElementStepped(bool isEnd) {
       statistic.numCoreLateElement++;
       statistic.numCoreLateCycle += lateCycles;
       late = true;
+      if (releaseElement->isElemFloatedToCache()) {
+        this->floatFeedback.numLateElements++;
+        this->floatFeedback.numLateCycles += lateCycles;
+      }
       if (lateCycles > 1000) {
         S_ELEMENT_DPRINTF_(
             StreamCritical, releaseElement,
@@ -886,6 +899,12 @@ void DynamicStream::updateStatsOnReleaseStepElement(Cycles releaseCycle,
     // Time to reset.
     this->lastReleaseCycle = releaseCycle;
     this->lateElementCount = 0;
+    // Check if the adaptive float policy wants to sink me.
+    if (this->isFloatedToCacheAsRoot() &&
+        this->stream->se->floatController->shouldSinkStream(*this)) {
+      this->tryCancelFloat();
+    }
+    this->floatFeedback = FloatFeedback();
   }
 }
 
@@ -969,6 +988,7 @@ void DynamicStream::cancelFloat() {
   this->setFloatedToCache(false);
   this->setFloatedToCacheAsRoot(false);
   this->floatPlan.clear();
+  this->floatCancelled = true;
   S->statistic.numFloatCancelled++;
 }
 
@@ -53,6 +53,11 @@ struct DynamicStream {
   FIFOEntryIdx FIFOIdx;
   // A hack to store how many elements has the cache acked.
   std::set<uint64_t> cacheAckedElements;
+  /**
+   * Record the ack and wake up core instructions waiting for it,
+   * e.g. StreamEnd.
+   */
+  void cacheAckElement(uint64_t elementIdx);
 
   /**
    * Offload flags are now set to private.
@@ -148,6 +153,20 @@ public:
   DynamicStreamFormalParamV addrGenFormalParams;
   AddrGenCallbackPtr addrGenCallback;
 
+  /**
+   * For vector streams whose inner trip count is not a multiple of
+   * VectorLanes, the last vector of each inner loop only has
+   * vectorTailLanes valid lanes. Zero if there is no partial tail.
+   */
+  int32_t vectorTailLanes = 0;
+  uint64_t vectorInnerTripCount = 0;
+  bool hasVectorTail() const { return this->vectorTailLanes != 0; }
+  bool isVectorTailElement(uint64_t elementIdx) const {
+    return this->hasVectorTail() &&
+           (elementIdx % this->vectorInnerTripCount) ==
+               this->vectorInnerTripCount - 1;
+  }
+
   // Predication compute.
   DynamicStreamFormalParamV predFormalParams;
   ExecFuncPtr predCallback;
@@ -355,6 +374,26 @@ public:
   void dump() const;
   std::string dumpString() const;
 
+  /**
+   * Runtime feedback of the floated stream. Lateness is recorded by the
+   * core SE when a used floated element is released, and hops by the LLC
+   * SE when it sends the data to the MLC. Used by the adaptive float policy
+   * to decide if the stream should be sunk back to the core. Cleared every
+   * HistoryWindowSize released elements.
+   */
+  struct FloatFeedback {
+    uint64_t numElements = 0;
+    // Elements the core waited for.
+    uint64_t numLateElements = 0;
+    uint64_t numLateCycles = 0;
+    // Mesh hops from the LLC bank to the MLC.
+    uint64_t numHopSlices = 0;
+    uint64_t numHops = 0;
+  };
+  FloatFeedback floatFeedback;
+  // Whether the float is cancelled midway, i.e. sunk back to the core.
+  bool floatCancelled = false;
+
 private:
   /**
    * Remember the total trip count.
@@ -234,6 +234,8 @@ void Stream::executeStreamConfig(uint64_t seqNum,
   auto &dynStream = this->getDynamicStream(seqNum);
   assert(!dynStream.configExecuted && "StreamConfig already executed.");
   dynStream.configExecuted = true;
+  // StreamEnd may be waiting for the config.
+  this->getCPUDelegator()->wakeupGemForgeInsts();
 
   /**
    * We intercept the extra input value here.
@@ -418,6 +420,7 @@ void Stream::recordAggregateHistory(const DynamicStream &dynS) {
   history.numPrivateCacheHits = dynS.getTotalHitPrivateCache();
   history.startVAddr = dynS.getStartVAddr();
   history.floated = dynS.isFloatedToCache();
+  history.floatCancelled = dynS.floatCancelled;
 }
 
 DynamicStream &Stream::getDynamicStreamByInstance(InstanceId instance) {
@@ -510,6 +513,37 @@ void Stream::setupLinearAddrFunc(DynamicStream &dynStream,
 
   assert(inputIdx == inputVec->size() && "Unused input value.");
 
+  /**
+   * Vector stream packs VectorLanes consecutive elements into one element.
+   * Scale the inner stride and divide the inner trip count (rounding up).
+   * The last vector of each inner loop may be partial: remember its valid
+   * lanes so the element size is clamped to stay within the array. This is
+   * only supported for loads, so other streams require the trip count to be
+   * a multiple of VectorLanes.
+   */
+  auto vectorLanes = this->getVectorLanes();
+  if (vectorLanes > 1) {
+    auto scalarSize = this->getMemElementSize() / vectorLanes;
+    auto &stride = formalParams.at(0).invariant.uint64();
+    if (static_cast<int64_t>(stride) != scalarSize) {
+      DYN_S_PANIC(dynStream.dynamicStreamId,
+                  "VectorLanes %d with non-unit stride %lld.", vectorLanes,
+                  static_cast<int64_t>(stride));
+    }
+    stride *= vectorLanes;
+    if (formalParams.size() > 2) {
+      auto &tripCount = formalParams.at(1).invariant.uint64();
+      if (tripCount % vectorLanes != 0 && !this->isLoadStream()) {
+        DYN_S_PANIC(dynStream.dynamicStreamId,
+                    "TripCount %llu not multiple of VectorLanes %d.",
+                    tripCount, vectorLanes);
+      }
+      dynStream.vectorTailLanes = tripCount % vectorLanes;
+      tripCount = (tripCount + vectorLanes - 1) / vectorLanes;
+      dynStream.vectorInnerTripCount = tripCount;
+    }
+  }
+
   /**
    * We have to process the params to compute TotalTripCount for each nested
    * loop.
@@ -637,8 +671,12 @@ void Stream::extractExtraInputValues(DynamicStream &dynS,
    */
   assert(inputVec && "Missing InputVec.");
   const auto &mergedPredicatedStreams = this->getMergedPredicatedStreams();
-  if (mergedPredicatedStreams.size() > 0) {
+  if (mergedPredicatedStreams.size() > 0 ||
+      this->isPredicatedReduction()) {
     const auto &predFuncInfo = this->getPredicateFuncInfo();
+    if (this->isPredicatedReduction() && predFuncInfo.name() == "") {
+      S_PANIC(this, "PredicatedReduction without PredicateFunc.");
+    }
     if (!this->predCallback) {
       this->predCallback =
           std::make_shared<TheISA::ExecFunc>(dynS.tc, predFuncInfo);
@@ -72,17 +72,29 @@ public:
   bool getFloatManual() const {
     return this->info.static_info().float_manual();
   }
+  ::LLVM::TDG::StreamStepPattern getStepPattern() const {
+    return this->info.static_info().stp_pattern();
+  }
   uint64_t getCoalesceBaseStreamId() const {
     return this->info.coalesce_info().base_stream();
   }
   int32_t getCoalesceOffset() const {
     return this->info.coalesce_info().offset();
   }
+  int32_t getVectorLanes() const {
+    auto lanes = this->info.static_info().vector_lanes();
+    return lanes > 1 ? lanes : 1;
+  }
+  /**
+   * Element sizes already include all the vector lanes.
+   */
   int32_t getMemElementSize() const {
-    return this->info.static_info().mem_element_size();
+    return this->info.static_info().mem_element_size() *
+           this->getVectorLanes();
   }
   int32_t getCoreElementSize() const {
-    return this->info.static_info().core_element_size();
+    return this->info.static_info().core_element_size() *
+           this->getVectorLanes();
   }
   const PredicatedStreamIdList &getMergedPredicatedStreams() const {
     return this->info.static_info().merged_predicated_streams();
@@ -126,6 +138,15 @@ public:
   bool getReduceFromZero() const {
     return this->info.static_info().compute_info().reduce_from_zero();
   }
+  ::LLVM::TDG::StreamMergeInfo_MergeOp getMergeOp() const {
+    return this->info.static_info().compute_info().merge_info().op();
+  }
+  const StreamIdList &getMergeStreams() const {
+    return this->info.static_info().compute_info().merge_info().merge_streams();
+  }
+  bool getPredicatedReduce() const {
+    return this->info.static_info().compute_info().predicated_reduce();
+  }
   bool isLoopEliminated() const {
     return this->info.static_info().loop_eliminated();
   }
@@ -223,6 +244,14 @@ public:
   size_t stepSize;
   size_t maxSize;
   int lateFetchCount;
+  /**
+   * Used by the utility throttler. IdleFetchCount counts elements ready
+   * long before the first user, and ThrottleUtility is the smoothed late
+   * ratio of the step group (only valid for the step root stream).
+   */
+  int idleFetchCount = 0;
+  int throttleSampleCount = 0;
+  float throttleUtility = 0.0f;
   int numInflyStreamRequests = 0;
   void incrementInflyStreamRequest() { this->numInflyStreamRequests++; }
   void decrementInflyStreamRequest() {
@@ -441,6 +470,7 @@ public:
     uint64_t numPrivateCacheHits = 0;
     uint64_t startVAddr = 0;
     bool floated = false;
+    bool floatCancelled = false;
   };
   static constexpr int AggregateHistorySize = 4;
   std::list<StreamAggregateHistory> aggregateHistory;
@@ -452,7 +482,12 @@ public:
     return this->getComputeCallback()->getNumInstructions();
   }
   Cycles getEstimatedComputationLatency() const {
-    return this->getComputeCallback()->getEstimatedLatency();
+    auto latency = this->getComputeCallback()->getEstimatedLatency();
+    if (this->isPredicatedReduction() && this->predCallback) {
+      // The step predicate is evaluated before the reduction.
+      latency += this->predCallback->getEstimatedLatency();
+    }
+    return latency;
   }
   bool isSIMDComputation() const {
     return this->getComputeCallback()->hasSIMD();
@@ -592,6 +627,8 @@ public:
   Get(bool, IsInnerMostLoop);
   Get(bool, IsConditional);
   Get(bool, FloatManual);
+  Get(::LLVM::TDG::StreamStepPattern, StepPattern);
+  Get(int32_t, VectorLanes);
   Get(const PredicatedStreamIdList &, MergedPredicatedStreams);
   Get(const ExecFuncInfo &, PredicateFuncInfo);
   Get(const StreamIdList &, MergedLoadStoreDepStreams);
@@ -601,6 +638,9 @@ public:
   Get(bool, EnabledStoreFunc);
   Get(bool, EnabledLoadFunc);
   Get(bool, ReduceFromZero);
+  Get(::LLVM::TDG::StreamMergeInfo_MergeOp, MergeOp);
+  Get(const StreamIdList &, MergeStreams);
+  Get(bool, PredicatedReduce);
   Get(::LLVM::TDG::ExecFuncInfo_ComputeOp, AddrFuncComputeOp);
   Is(MergedPredicated);
   Is(MergedLoadStoreDepStream);
@@ -661,6 +701,26 @@ public:
     return false;
   }
 
+  /**
+   * A MergeStream is a reduction over the keys matched by merging two sorted
+   * key streams, instead of over the elements in lockstep.
+   */
+  bool isMergeStream() const {
+    return this->isReduction() &&
+           this->getMergeOp() != ::LLVM::TDG::StreamMergeInfo_MergeOp_NONE;
+  }
+
+  /**
+   * A PredicatedReduction has one element per iteration, but only reduces
+   * the element if its PredicateFunc is true, e.g. a filtered scan.
+   * Otherwise the previous value is carried forward. The address streams
+   * still step every iteration.
+   */
+  bool isPredicatedReduction() const {
+    return this->isReduction() && !this->isMergeStream() &&
+           this->getPredicatedReduce();
+  }
+
   bool isPointerChase() const {
     return this->primeLogical->info.static_info().val_pattern() ==
            ::LLVM::TDG::StreamValuePattern::POINTER_CHASE;
@@ -1,6 +1,7 @@
 #include "stream_element.hh"
 #include "stream.hh"
 #include "stream_compute_engine.hh"
+#include "stream_event_tracer.hh"
 
 #include "cpu/gem_forge/llvm_trace_cpu.hh"
 
@@ -463,12 +464,19 @@ void StreamElement::markAddrReady() {
   assert(!this->addrReady && "Addr is already ready.");
   this->addrReady = true;
   this->addrReadyCycle = this->stream->se->curCycle();
+  StreamEventTracer::trace(StreamEventTracer::CoreAddrReady,
+                           this->FIFOIdx.streamId, this->FIFOIdx.entryIdx);
 
   /**
    * For non-mem streams, we set the address to 0 and directly set the value.
    * This is because other streams do not have address.
    */
   this->size = this->stream->getMemElementSize();
+  if (this->dynS->isVectorTailElement(this->FIFOIdx.entryIdx)) {
+    // Clamp the partial vector so we do not access beyond the array.
+    this->size = this->size / this->stream->getVectorLanes() *
+                 this->dynS->vectorTailLanes;
+  }
   if (this->stream->isMemStream()) {
     this->addr = this->computeAddr();
   } else {
@@ -478,6 +486,9 @@ void StreamElement::markAddrReady() {
   S_ELEMENT_DPRINTF(this, "MarkAddrReady vaddr %#x size %d.\n", this->addr,
                     this->size);
 
+  // Wake up core users waiting for the address, e.g. StreamStore.
+  this->se->getCPUDelegator()->wakeupGemForgeInsts();
+
   this->splitIntoCacheBlocks();
 
   /**
@@ -574,9 +585,17 @@ void StreamElement::computeValue() {
         return;
       }
     }
-    result = dynS->addrGenCallback->genAddr(
-        this->FIFOIdx.entryIdx, dynS->addrGenFormalParams, getBaseValue);
+    if (S->isPredicatedReduction() && !this->isReducePredicatedTrue()) {
+      // Predicated off, carry forward the previous value.
+      result = getBaseValue(S->staticId);
+    } else {
+      result = dynS->addrGenCallback->genAddr(
+          this->FIFOIdx.entryIdx, dynS->addrGenFormalParams, getBaseValue);
+    }
     estimatedLatency = dynS->addrGenCallback->getEstimatedLatency();
+    if (S->isPredicatedReduction()) {
+      estimatedLatency += dynS->predCallback->getEstimatedLatency();
+    }
   }
   /**
    * We try to model the computation overhead for StoreStream, UpdateStreawm
@@ -617,6 +636,8 @@ void StreamElement::markValueReady() {
   assert(!this->isValueReady && "Value is already ready.");
   this->isValueReady = true;
   this->valueReadyCycle = this->getStream()->getCPUDelegator()->curCycle();
+  StreamEventTracer::trace(StreamEventTracer::CoreValueReady,
+                           this->FIFOIdx.streamId, this->FIFOIdx.entryIdx);
   if (Debug::DEBUG_TYPE) {
     bool faulted = false;
     for (int blockIdx = 0; blockIdx < this->cacheBlocks; ++blockIdx) {
@@ -633,6 +654,9 @@ void StreamElement::markValueReady() {
     }
   }
 
+  // Wake up core users waiting for the value.
+  this->se->getCPUDelegator()->wakeupGemForgeInsts();
+
   // Notify the stream for statistics.
   if (this->issueCycle >= this->addrReadyCycle &&
       this->issueCycle <= this->valueReadyCycle) {
@@ -775,6 +799,17 @@ void StreamElement::getValueByStreamId(StaticId streamId, uint8_t *val,
   this->stream->getCoalescedOffsetAndSize(streamId, offset, size);
   assert(size <= valLen && "ElementSize overflow.");
   vaddr += offset;
+  /**
+   * The partial tail of a vector stream only has this->size valid bytes.
+   * Zero the lanes beyond the array instead of reading them.
+   */
+  if (offset + size > this->size) {
+    assert(this->dynS->isVectorTailElement(this->FIFOIdx.entryIdx) &&
+           "Value beyond non-vector-tail element.");
+    int validSize = this->size - offset;
+    std::fill(val + validSize, val + size, 0);
+    size = validSize;
+  }
   this->getValue(vaddr, size, val);
 }
 
@@ -818,6 +853,7 @@ void StreamElement::receiveComputeResult(const StreamValue &result) {
     S_ELEMENT_DPRINTF(this, "Mark UpdateValue Ready.\n");
     this->updateValue = result;
     this->updateValueReady = true;
+    this->se->getCPUDelegator()->wakeupGemForgeInsts();
   } else if (this->stream->isLoadComputeStream()) {
     if (this->isLoadComputeValueReady()) {
       S_ELEMENT_PANIC(this, "LoadComputeValue already ready.");
@@ -825,11 +861,23 @@ void StreamElement::receiveComputeResult(const StreamValue &result) {
     S_ELEMENT_DPRINTF(this, "Mark LoadComputeValue Ready.\n");
     this->loadComputeValue = result;
     this->loadComputeValueReady = true;
+    this->se->getCPUDelegator()->wakeupGemForgeInsts();
   } else {
     this->setValue(this->addr, this->size, result.uint8Ptr());
   }
 }
 
+bool StreamElement::isReducePredicatedTrue() {
+  auto getBaseValue = [this](StaticId id) -> StreamValue {
+    return this->getValueBaseByStreamId(id);
+  };
+  auto params =
+      convertFormalParamToParam(this->dynS->predFormalParams, getBaseValue);
+  bool predTrue = this->dynS->predCallback->invoke(params).front() & 0x1;
+  S_ELEMENT_DPRINTF(this, "ReducePredicate %d.\n", predTrue);
+  return predTrue;
+}
+
 StreamValue StreamElement::getValueBaseByStreamId(StaticId id) {
   // Search the ValueBaseElements.
   auto baseS = this->se->getStream(id);
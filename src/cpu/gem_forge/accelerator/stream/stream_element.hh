@@ -238,6 +238,10 @@ struct StreamElement {
                              sizeof(T));
   }
   StreamValue getValueBaseByStreamId(StaticId id);
+  /**
+   * Evaluate the predicate of PredicatedReduction.
+   */
+  bool isReducePredicatedTrue();
   bool isValueFaulted(Addr vaddr, int size) const;
 
   /**
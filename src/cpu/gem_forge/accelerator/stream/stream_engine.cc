@@ -2,6 +2,7 @@
 #include "cpu/gem_forge/llvm_trace_cpu_delegator.hh"
 #include "stream_compute_engine.hh"
 #include "stream_data_traffic_accumulator.hh"
+#include "stream_event_tracer.hh"
 #include "stream_float_controller.hh"
 #include "stream_lsq_callback.hh"
 #include "stream_ndc_controller.hh"
@@ -9,6 +10,9 @@
 #include "stream_region_controller.hh"
 #include "stream_throttler.hh"
 
+#include "cache/LLCDynamicStream.hh"
+
+#include "base/host_profile.hh"
 #include "base/trace.hh"
 #include "debug/CoreRubyStreamLife.hh"
 #include "debug/CoreStreamAlloc.hh"
@@ -62,10 +66,20 @@ StreamEngine::StreamEngine(Params *params)
   this->enableStreamFloatIndirect = params->streamEngineEnableFloatIndirect;
   this->enableStreamFloatPseudo = params->streamEngineEnableFloatPseudo;
   this->enableStreamFloatCancel = params->streamEngineEnableFloatCancel;
-
+  this->enableAdaptiveFloat =
+      this->enableStreamFloat && params->streamEngineFloatPolicy == "adaptive";
+
+  StreamFloatPolicy::SinkThresholds sinkThresholds;
+  sinkThresholds.hitRate = params->streamEngineSinkHitRate;
+  sinkThresholds.partialHitRate = params->streamEngineSinkPartialHitRate;
+  sinkThresholds.lateRatio = params->streamEngineSinkLateRatio;
+  sinkThresholds.avgHops = params->streamEngineSinkAvgHops;
+  sinkThresholds.minFeedbackElements =
+      params->streamEngineSinkMinFeedbackElements;
   auto streamFloatPolicy = m5::make_unique<StreamFloatPolicy>(
       this->enableStreamFloat, params->enableFloatMem,
-      params->streamEngineFloatPolicy, params->floatLevelPolicy);
+      params->streamEngineFloatPolicy, params->floatLevelPolicy,
+      sinkThresholds);
   this->floatController = m5::make_unique<StreamFloatController>(
       this, std::move(streamFloatPolicy));
 
@@ -82,6 +96,10 @@ StreamEngine::StreamEngine(Params *params)
       );
 
   this->initializeFIFO(this->totalRunAheadLength);
+
+  if (params->enableEventTrace) {
+    StreamEventTracer::initialize(params->eventTraceBufferRecords);
+  }
 }
 
 StreamEngine::~StreamEngine() {
@@ -296,8 +314,9 @@ bool StreamEngine::canStreamConfig(const StreamConfigArgs &args) const {
       auto iter = this->streamMap.find(streamId);
       if (iter != this->streamMap.end()) {
         // Check if we have quota for this stream.
+        // MaxSize may be shrunk below AllocSize by the throttler.
         auto S = iter->second;
-        if (S->getAllocSize() == S->maxSize) {
+        if (S->getAllocSize() >= S->maxSize) {
           // No more quota.
           return false;
         }
@@ -310,7 +329,7 @@ bool StreamEngine::canStreamConfig(const StreamConfigArgs &args) const {
       if (iter != this->streamMap.end()) {
         // Check if we have quota for this stream.
         auto S = iter->second;
-        if (S->getAllocSize() == S->maxSize) {
+        if (S->getAllocSize() >= S->maxSize) {
           // No more quota.
           return false;
         }
@@ -355,6 +374,8 @@ void StreamEngine::dispatchStreamConfig(const StreamConfigArgs &args) {
 
     // Notify the stream.
     S->configure(args.seqNum, args.tc);
+    StreamEventTracer::trace(StreamEventTracer::CoreConfig,
+                             S->getLastDynamicStream().dynamicStreamId, 0);
   }
 
   // Handle dynamic stream dependence.
@@ -1417,6 +1438,8 @@ void StreamEngine::commitStreamEnd(const StreamEndArgs &args) {
      */
     while (this->releaseElementUnstepped(endedDynS)) {
     }
+    StreamEventTracer::trace(StreamEventTracer::CoreEnd,
+                             endedDynS.dynamicStreamId, 0);
 
     /**
      * Release the last element we stepped at dispatch.
@@ -1689,6 +1712,31 @@ void StreamEngine::initializeStreams(
       newStream->setNested();
     }
   }
+  /**
+   * Vector streams only pack consecutive elements for plain memory accesses.
+   * Computation and indirect streams still operate on one scalar element.
+   */
+  for (auto newStream : createdStreams) {
+    if (newStream->getVectorLanes() > 1) {
+      if (newStream->isLoadComputeStream() || newStream->isUpdateStream() ||
+          newStream->getEnabledStoreFunc() || newStream->isReduction()) {
+        S_PANIC(newStream, "VectorLanes %d on computation stream.",
+                newStream->getVectorLanes());
+      }
+    }
+    for (auto baseS : newStream->addrBaseStreams) {
+      if (baseS->getVectorLanes() > 1) {
+        S_PANIC(newStream, "Indirect stream based on vector stream %s.",
+                baseS->getStreamName());
+      }
+    }
+    for (auto baseS : newStream->valueBaseStreams) {
+      if (baseS->getVectorLanes() > 1) {
+        S_PANIC(newStream, "Computation based on vector stream %s.",
+                baseS->getStreamName());
+      }
+    }
+  }
   /**
    * ! Hack: Some stream has crazy large element size, e.g. vectorized
    * ! stream_memset, we should limit the maxSize for them to 2.
@@ -1706,6 +1754,27 @@ void StreamEngine::initializeStreams(
     }
   }
 
+  for (auto newStream : createdStreams) {
+    StreamEventTracer::registerStream(cpuDelegator->cpuId(),
+                                      newStream->staticId,
+                                      newStream->getStreamName());
+  }
+
+  // Restore the warm state from checkpoint.
+  for (auto newStream : createdStreams) {
+    auto iter = this->checkpointStreamStates.find(newStream->staticId);
+    if (iter == this->checkpointStreamStates.end()) {
+      continue;
+    }
+    SE_DPRINTF_(StreamThrottle,
+                "[Throttle] Restore %s MaxSize %d -> %d DynInstance %lu.\n",
+                newStream->getStreamName(), newStream->maxSize,
+                iter->second.maxSize, iter->second.dynInstance);
+    newStream->maxSize = iter->second.maxSize;
+    newStream->dynInstance = iter->second.dynInstance;
+    this->checkpointStreamStates.erase(iter);
+  }
+
   // Recursively initialize all nest streams.
   this->regionController->initializeRegion(streamRegion);
   for (const auto nestRegionRelativePath :
@@ -1770,6 +1839,7 @@ void StreamEngine::generateCoalescedStreamIdMap(
     auto endOffset = baseOffset;
     auto baseSEnabledStoreFunc =
         baseS->static_info().compute_info().enabled_store_func();
+    auto baseSIsVector = baseS->static_info().vector_lanes() > 1;
     size_t nStream = 0;
     for (auto streamIter = groupIter->begin(), streamEnd = groupIter->end();
          streamIter != streamEnd; ++streamIter, ++nStream) {
@@ -1777,13 +1847,16 @@ void StreamEngine::generateCoalescedStreamIdMap(
       auto offset = streamInfo->coalesce_info().offset();
       auto enabledStoreFunc =
           streamInfo->static_info().compute_info().enabled_store_func();
+      auto isVector = streamInfo->static_info().vector_lanes() > 1;
       if ((!this->enableCoalesce && nStream == 1) || offset > endOffset ||
-          enabledStoreFunc != baseSEnabledStoreFunc) {
+          enabledStoreFunc != baseSEnabledStoreFunc ||
+          (nStream > 0 && (isVector || baseSIsVector))) {
         /**
          * Split the group if one of the following happens:
          * 1. We explicitly disabled coalescing.
          * 2. The expansion is broken.
          * 3. The new stream has different enabledStoreFunc than the baseS.
+         * 4. Either is a vector stream, which is never coalesced.
          */
         assert(nStream != 0 && "Emplty LHS group.");
         coalescedGroup.emplace_back(streamIter, streamEnd);
@@ -1861,7 +1934,10 @@ Stream *StreamEngine::tryGetStream(uint64_t streamId) const {
   return iter->second;
 }
 
+HOST_PROFILE_COUNTER(hostProfileSETick, "stream.se.tick");
+
 void StreamEngine::tick() {
+  HOST_PROFILE_SCOPE(hostProfileSETick);
   this->regionController->tick();
   this->issueElements();
   this->computeEngine->startComputation();
@@ -2052,6 +2128,9 @@ void StreamEngine::allocateElement(DynamicStream &dynS) {
   }
 
   dynS.allocateElement(newElement);
+  StreamEventTracer::trace(StreamEventTracer::CoreAlloc,
+                           newElement->FIFOIdx.streamId,
+                           newElement->FIFOIdx.entryIdx);
 }
 
 void StreamEngine::releaseElementStepped(DynamicStream *dynS, bool isEnd,
@@ -2064,6 +2143,9 @@ void StreamEngine::releaseElementStepped(DynamicStream *dynS, bool isEnd,
   auto S = dynS->stream;
 
   auto releaseElement = dynS->releaseElementStepped(isEnd);
+  StreamEventTracer::trace(StreamEventTracer::CoreRelease,
+                           releaseElement->FIFOIdx.streamId,
+                           releaseElement->FIFOIdx.entryIdx);
   /**
    * How to handle short streams?
    * There is a pathological case when the streams are short, and
@@ -2517,6 +2599,9 @@ void StreamEngine::issueElement(StreamElement *element) {
 
   auto S = element->stream;
   auto dynS = element->dynS;
+  StreamEventTracer::trace(StreamEventTracer::CoreIssue,
+                           element->FIFOIdx.streamId,
+                           element->FIFOIdx.entryIdx);
   if (element->flushed) {
     if (!S->trackedByPEB()) {
       S_ELEMENT_PANIC(element, "Flushed Non-PEB stream element.");
@@ -2992,6 +3077,76 @@ bool StreamEngine::checkProgress() {
   return hasProgress;
 }
 
+void StreamEngine::serialize(CheckpointOut &cp) const {
+  if (!this->cpuDelegator) {
+    // Not attached to any cpu, e.g. switched out.
+    return;
+  }
+  // Our name() is "global" for all cores, so save in our own section.
+  ScopedCheckpointSection sec(cp,
+                              csprintf("se%d", this->cpuDelegator->cpuId()));
+  /**
+   * This is a warm-state only checkpoint: we save the per-stream maxSize
+   * and dynInstance, but not the DynamicStreams, FIFO StreamElements or
+   * LLCDynamicStreams. So we can only checkpoint outside a stream region.
+   */
+  if (this->numInflyStreamConfigurations != 0) {
+    fatal("[SE%d] Cannot checkpoint with %d infly StreamConfig.",
+          this->cpuDelegator->cpuId(), this->numInflyStreamConfigurations);
+  }
+  if (LLCDynamicStream::getNumLLCStreams() != 0) {
+    fatal("[SE%d] Cannot checkpoint with %lu LLC streams.",
+          this->cpuDelegator->cpuId(), LLCDynamicStream::getNumLLCStreams());
+  }
+  std::vector<StreamId> streamIds;
+  std::vector<size_t> maxSizes;
+  std::vector<DynamicStreamId::InstanceId> dynInstances;
+  for (const auto &IdStream : this->streamMap) {
+    auto S = IdStream.second;
+    if (S->isConfigured()) {
+      fatal("[SE%d] Cannot checkpoint with configured stream %s.",
+            this->cpuDelegator->cpuId(), S->getStreamName());
+    }
+    streamIds.push_back(S->staticId);
+    maxSizes.push_back(S->maxSize);
+    dynInstances.push_back(S->dynInstance);
+  }
+  // Keep the restored state of streams not created since the restore.
+  for (const auto &entry : this->checkpointStreamStates) {
+    streamIds.push_back(entry.first);
+    maxSizes.push_back(entry.second.maxSize);
+    dynInstances.push_back(entry.second.dynInstance);
+  }
+  arrayParamOut(cp, "streamIds", streamIds);
+  arrayParamOut(cp, "maxSizes", maxSizes);
+  arrayParamOut(cp, "dynInstances", dynInstances);
+}
+
+void StreamEngine::unserialize(CheckpointIn &cp) {
+  if (!this->cpuDelegator) {
+    return;
+  }
+  ScopedCheckpointSection sec(cp,
+                              csprintf("se%d", this->cpuDelegator->cpuId()));
+  if (!cp.sectionExists(Serializable::currentSection())) {
+    return;
+  }
+  std::vector<StreamId> streamIds;
+  std::vector<size_t> maxSizes;
+  std::vector<DynamicStreamId::InstanceId> dynInstances;
+  arrayParamIn(cp, "streamIds", streamIds);
+  arrayParamIn(cp, "maxSizes", maxSizes);
+  arrayParamIn(cp, "dynInstances", dynInstances);
+  assert(streamIds.size() == maxSizes.size() &&
+         streamIds.size() == dynInstances.size());
+  this->checkpointStreamStates.clear();
+  for (size_t i = 0; i < streamIds.size(); ++i) {
+    this->checkpointStreamStates.emplace(
+        std::piecewise_construct, std::forward_as_tuple(streamIds[i]),
+        std::forward_as_tuple(maxSizes[i], dynInstances[i]));
+  }
+}
+
 size_t StreamEngine::getTotalRunAheadLength() const {
   size_t totalRunAheadLength = 0;
   for (const auto &IdStream : this->streamMap) {
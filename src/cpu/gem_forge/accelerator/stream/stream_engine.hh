@@ -46,6 +46,15 @@ public:
   void regStats() override;
   void resetStats() override;
 
+  /**
+   * Checkpoint is only supported when no stream is configured, i.e. all
+   * FIFO and LLC/MLC stream state is empty. We still keep the warm state of
+   * the streams, e.g. the throttled run ahead length, so that a restored run
+   * does not start throttling from scratch.
+   */
+  void serialize(CheckpointOut &cp) const override;
+  void unserialize(CheckpointIn &cp) override;
+
   // Override the name as we don't want the default long name().
   const std::string name() const override { return "global"; }
 
@@ -198,6 +207,7 @@ public:
   bool isStreamFloatCancelEnabled() const {
     return this->enableStreamFloatCancel;
   }
+  bool isAdaptiveFloatEnabled() const { return this->enableAdaptiveFloat; }
   bool isStreamRangeSyncEnabled() const {
     return this->myParams->enableRangeSync;
   }
@@ -379,6 +389,19 @@ private:
    */
   std::unordered_map<StreamId, StreamId> coalescedStreamIdMap;
 
+  /**
+   * Stream state restored from checkpoint. Streams are lazily created, so
+   * this is applied in initializeStreams().
+   */
+  struct CheckpointStreamState {
+    size_t maxSize;
+    DynamicStreamId::InstanceId dynInstance;
+    CheckpointStreamState(size_t _maxSize,
+                          DynamicStreamId::InstanceId _dynInstance)
+        : maxSize(_maxSize), dynInstance(_dynInstance) {}
+  };
+  std::unordered_map<StreamId, CheckpointStreamState> checkpointStreamStates;
+
   /**
    * Flags.
    */
@@ -398,6 +421,7 @@ private:
   bool enableStreamFloatIndirect;
   bool enableStreamFloatPseudo;
   bool enableStreamFloatCancel;
+  bool enableAdaptiveFloat;
   std::string placementLat;
   std::string placement;
   /**
@@ -0,0 +1,176 @@
+#include "stream_event_tracer.hh"
+
+#include "base/callback.hh"
+#include "base/output.hh"
+#include "sim/core.hh"
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+bool StreamEventTracer::enabled = false;
+
+namespace {
+
+using Record = StreamEventTracer::Record;
+using Buffer = std::vector<Record>;
+
+/**
+ * Per host thread buffer, so appending needs no lock.
+ */
+struct ThreadBuffer {
+  Buffer records;
+  bool registered = false;
+};
+thread_local ThreadBuffer threadBuffer;
+
+/**
+ * Owns the output files and the background writer thread. Full buffers
+ * are queued to the writer and recycled after written.
+ */
+class TraceWriter {
+public:
+  TraceWriter(int _bufferRecords) : bufferRecords(_bufferRecords) {
+    auto directory = simout.findOrCreateSubdirectory("stream_event_trace");
+    this->eventStream = directory->create("events.bin", true /* binary */);
+    this->nameStream = directory->create("streams.txt");
+    // Header: magic, version, record size.
+    const uint32_t header[2] = {1, sizeof(Record)};
+    this->eventStream->stream()->write("GFSEVT\0\0", 8);
+    this->eventStream->stream()->write(reinterpret_cast<const char *>(header),
+                                       sizeof(header));
+    this->writer = std::thread(&TraceWriter::run, this);
+  }
+
+  void append(const Record &record) {
+    auto &buffer = threadBuffer;
+    if (!buffer.registered) {
+      std::lock_guard<std::mutex> guard(this->mutex);
+      buffer.records.reserve(this->bufferRecords);
+      this->threadBuffers.push_back(&buffer);
+      buffer.registered = true;
+    }
+    buffer.records.push_back(record);
+    if (buffer.records.size() == this->bufferRecords) {
+      std::lock_guard<std::mutex> guard(this->mutex);
+      this->pending.push_back(std::move(buffer.records));
+      if (this->freeBuffers.empty()) {
+        buffer.records = Buffer();
+        buffer.records.reserve(this->bufferRecords);
+      } else {
+        buffer.records = std::move(this->freeBuffers.back());
+        this->freeBuffers.pop_back();
+      }
+      this->cv.notify_one();
+    }
+  }
+
+  void registerStream(int coreId, uint64_t staticId,
+                      const std::string &name) {
+    std::lock_guard<std::mutex> guard(this->mutex);
+    *this->nameStream->stream() << coreId << ' ' << staticId << ' ' << name
+                                << '\n';
+  }
+
+  /**
+   * Flush all thread buffers and stop the writer. Called at exit when no
+   * other thread is simulating.
+   */
+  void close() {
+    {
+      std::lock_guard<std::mutex> guard(this->mutex);
+      for (auto buffer : this->threadBuffers) {
+        if (!buffer->records.empty()) {
+          this->pending.push_back(std::move(buffer->records));
+          buffer->records = Buffer();
+        }
+      }
+      this->stopping = true;
+      this->cv.notify_one();
+    }
+    this->writer.join();
+    this->eventStream->stream()->flush();
+    this->nameStream->stream()->flush();
+  }
+
+private:
+  const size_t bufferRecords;
+  OutputStream *eventStream;
+  OutputStream *nameStream;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<Buffer> pending;
+  std::vector<Buffer> freeBuffers;
+  std::vector<ThreadBuffer *> threadBuffers;
+  bool stopping = false;
+  std::thread writer;
+
+  void run() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true) {
+      this->cv.wait(lock, [this]() -> bool {
+        return !this->pending.empty() || this->stopping;
+      });
+      if (this->pending.empty()) {
+        // Stopping and nothing to write.
+        break;
+      }
+      auto buffer = std::move(this->pending.front());
+      this->pending.pop_front();
+      lock.unlock();
+      this->eventStream->stream()->write(
+          reinterpret_cast<const char *>(buffer.data()),
+          buffer.size() * sizeof(Record));
+      buffer.clear();
+      lock.lock();
+      this->freeBuffers.push_back(std::move(buffer));
+    }
+  }
+};
+
+TraceWriter *traceWriter = nullptr;
+
+class TraceExitCallback : public Callback {
+public:
+  void process() override {
+    StreamEventTracer::disable();
+    traceWriter->close();
+  }
+};
+
+} // namespace
+
+void StreamEventTracer::initialize(int bufferRecords) {
+  if (traceWriter) {
+    return;
+  }
+  assert(bufferRecords > 0 && "Invalid StreamEventTracer buffer size.");
+  traceWriter = new TraceWriter(bufferRecords);
+  registerExitCallback(new TraceExitCallback());
+  enabled = true;
+}
+
+void StreamEventTracer::registerStream(int coreId, uint64_t staticId,
+                                       const std::string &name) {
+  if (enabled) {
+    traceWriter->registerStream(coreId, staticId, name);
+  }
+}
+
+void StreamEventTracer::append(EventType type, const DynamicStreamId &dynId,
+                               uint64_t elementIdx, int bank) {
+  Record record;
+  std::memset(&record, 0, sizeof(record));
+  record.tick = curTick();
+  record.staticId = dynId.staticId;
+  record.elementIdx = elementIdx;
+  record.instanceId = dynId.streamInstance;
+  record.coreId = dynId.coreId;
+  record.bank = bank;
+  record.type = type;
+  traceWriter->append(record);
+}
@@ -0,0 +1,84 @@
+#ifndef __CPU_GEM_FORGE_ACCELERATOR_STREAM_EVENT_TRACER_HH__
+#define __CPU_GEM_FORGE_ACCELERATOR_STREAM_EVENT_TRACER_HH__
+
+#include "cache/DynamicStreamId.hh"
+
+#include "base/types.hh"
+
+#include <cstdint>
+#include <string>
+
+/**
+ * A low overhead binary tracer for stream lifecycle events in core, MLC and
+ * LLC stream engines. Unlike the debug flags, each event is a fixed size
+ * record appended to a per-thread buffer. Full buffers are handed to a
+ * background thread to write, and all buffers are flushed at exit.
+ *
+ * The output is stream_event_trace/events.bin, plus streams.txt mapping
+ * stream ids to names. See util/stream_event_trace.py to convert it to
+ * Chrome trace format.
+ */
+class StreamEventTracer {
+public:
+  enum EventType : uint8_t {
+    CoreConfig = 0,
+    CoreAlloc,
+    CoreAddrReady,
+    CoreIssue,
+    CoreValueReady,
+    CoreRelease,
+    CoreEnd,
+    MLCConfig,
+    MLCReceive,
+    MLCEnd,
+    LLCConfig,
+    LLCIssue,
+    LLCMigrateOut,
+    LLCMigrateIn,
+    LLCEnd,
+    // ElementIdx is the new MaxSize.
+    CoreThrottle,
+    NumEventTypes,
+  };
+
+  struct Record {
+    uint64_t tick;
+    uint64_t staticId;
+    uint64_t elementIdx;
+    uint32_t instanceId;
+    int16_t coreId;
+    // Bank of MLC/LLC events, -1 for core events.
+    int16_t bank;
+    uint8_t type;
+    uint8_t padding[7];
+  };
+  static_assert(sizeof(Record) == 40, "StreamEventTracer record size.");
+
+  /**
+   * Enable the tracer. Can be called by every stream engine.
+   */
+  static void initialize(int bufferRecords);
+
+  static bool isEnabled() { return enabled; }
+  static void disable() { enabled = false; }
+
+  static void trace(EventType type, const DynamicStreamId &dynId,
+                    uint64_t elementIdx, int bank = -1) {
+    if (enabled) {
+      append(type, dynId, elementIdx, bank);
+    }
+  }
+
+  /**
+   * Record the name of a static stream. Only called once per stream.
+   */
+  static void registerStream(int coreId, uint64_t staticId,
+                             const std::string &name);
+
+private:
+  static bool enabled;
+  static void append(EventType type, const DynamicStreamId &dynId,
+                     uint64_t elementIdx, int bank);
+};
+
+#endif
@@ -2,6 +2,12 @@
 
 #include "stream_region_controller.hh"
 
+#include "cache/LLCDynamicStream.hh"
+#include "cpu/base.hh"
+#include "cpu/thread_context.hh"
+#include "sim/stream_nuca/stream_nuca_manager.hh"
+#include "sim/system.hh"
+
 #define SE_DPRINTF_(X, format, args...)                                        \
   DPRINTF(X, "[SE%d]: " format, this->se->cpuDelegator->cpuId(), ##args)
 #define SE_DPRINTF(format, args...)                                            \
@@ -20,6 +26,16 @@ void StreamFloatController::floatStreams(
     const StreamConfigArgs &args, const ::LLVM::TDG::StreamRegion &region,
     std::list<DynamicStream *> &dynStreams) {
 
+  /**
+   * MergeStream can only be executed in the LLC, check the requirements
+   * before making any float decision.
+   */
+  for (auto dynS : dynStreams) {
+    if (dynS->stream->isMergeStream()) {
+      this->checkMergeStream(dynS);
+    }
+  }
+
   if (!this->se->enableStreamFloat) {
     return;
   }
@@ -31,6 +47,9 @@ void StreamFloatController::floatStreams(
     return;
   }
 
+  // Migrate before any InitPAddr is translated.
+  this->tryStreamNUCAOnlineMigration();
+
   auto *cacheStreamConfigVec = new CacheStreamConfigureVec();
   StreamCacheConfigMap offloadedStreamConfigMap;
   SE_DPRINTF("Consider StreamFloat for %s.\n", region.region());
@@ -57,6 +76,14 @@ void StreamFloatController::floatStreams(
   this->floatIndirectReductionStreams(floatArgs);
   this->floatTwoLevelIndirectStoreComputeStreams(floatArgs);
 
+  for (auto dynS : dynStreams) {
+    auto S = dynS->stream;
+    if (S->isMergeStream() && !floatArgs.floatedMap.count(S)) {
+      S_FATAL(S, "MergeStream requires all BackBaseStreams floated as "
+                 "DirectStreams, check the float policy.");
+    }
+  }
+
   if (cacheStreamConfigVec->empty()) {
     delete cacheStreamConfigVec;
     return;
@@ -67,6 +94,7 @@ void StreamFloatController::floatStreams(
 
   this->setFirstOffloadedElementIdx(floatArgs);
   this->propagateFloatPlan(floatArgs);
+  this->decideParallelReductionStreams(floatArgs);
 
   /**
    * Sanity check for some offload decision.
@@ -92,6 +120,9 @@ void StreamFloatController::floatStreams(
       if (S->isMergedPredicated()) {
         S_PANIC(S, "MergedStream not offloaded.");
       }
+      if (S->isMergeStream()) {
+        S_PANIC(S, "MergeStream not offloaded.");
+      }
     }
   }
 
@@ -269,6 +300,57 @@ void StreamFloatController::endFloatStreams(const DynStreamVec &dynStreams) {
   }
 }
 
+void StreamFloatController::tryStreamNUCAOnlineMigration() {
+  auto tc = this->se->cpuDelegator->getSingleThreadContext();
+  auto streamNUCAManager = tc->getStreamNUCAManager();
+  if (!streamNUCAManager->isOnlineMigrationEnabled() ||
+      !streamNUCAManager->isOnlineMigrationPending()) {
+    return;
+  }
+  if (!this->isQuiescedForStreamNUCAMigration(tc)) {
+    // Keep it pending and try again at the next StreamConfig.
+    SE_DPRINTF("Delay StreamNUCA online migration as not quiesced.\n");
+    streamNUCAManager->sampleOnlineMigrationBlocked();
+    return;
+  }
+  SE_DPRINTF("Try StreamNUCA online migration.\n");
+  streamNUCAManager->tryOnlineMigration(tc);
+}
+
+bool StreamFloatController::isQuiescedForStreamNUCAMigration(
+    ThreadContext *tc) const {
+  /**
+   * The remap only updates the page table and flushes the TLBs, thus we
+   * require that nothing holds a translated paddr:
+   * 1. No floating stream in the LLC.
+   * 2. No access in any core's LSQ.
+   * 3. No stream request in flight, and no configured stream except the
+   * StreamConfig being executed here, which has not translated anything.
+   */
+  if (LLCDynamicStream::getNumLLCStreams() != 0) {
+    return false;
+  }
+  for (auto otherTC : tc->getSystemPtr()->threadContexts) {
+    auto cpu = otherTC->getCpuPtr();
+    auto cpuDelegator = cpu->getCPUDelegator();
+    if (!cpuDelegator || !cpuDelegator->isMemQuiesced()) {
+      return false;
+    }
+    auto accelManager = cpu->getAccelManager();
+    if (!accelManager) {
+      continue;
+    }
+    if (auto otherSE = accelManager->getStreamEngine()) {
+      auto allowedConfigs = (otherSE == this->se) ? 1 : 0;
+      if (otherSE->numInflyStreamRequests != 0 ||
+          otherSE->numInflyStreamConfigurations > allowedConfigs) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 void StreamFloatController::floatDirectLoadStreams(const Args &args) {
   auto &floatedMap = args.floatedMap;
   for (auto dynS : args.dynStreams) {
@@ -419,79 +501,124 @@ void StreamFloatController::floatIndirectStreams(const Args &args) {
   if (!this->se->enableStreamFloatIndirect) {
     return;
   }
-  auto &floatedMap = args.floatedMap;
-  for (auto dynS : args.dynStreams) {
-    auto S = dynS->stream;
-    if (floatedMap.count(S)) {
-      continue;
+  /**
+   * With multi-level indirection, the AddrBaseStream may be floated after
+   * its user in this pass, so we repeat until nothing is floated.
+   */
+  bool floatedNewStream = true;
+  while (floatedNewStream) {
+    floatedNewStream = false;
+    for (auto dynS : args.dynStreams) {
+      if (this->floatIndirectStream(args, dynS)) {
+        floatedNewStream = true;
+      }
     }
-    if (S->isDirectMemStream() || S->isPointerChase()) {
-      continue;
+    if (!this->se->myParams->enableFloatMultiLevelIndirect) {
+      break;
     }
-    if (!S->isLoadStream() && !S->isAtomicComputeStream()) {
-      continue;
+  }
+}
+
+bool StreamFloatController::floatIndirectStream(const Args &args,
+                                                DynamicStream *dynS) {
+  auto &floatedMap = args.floatedMap;
+  auto S = dynS->stream;
+  if (floatedMap.count(S)) {
+    return false;
+  }
+  if (S->isDirectMemStream() || S->isPointerChase()) {
+    return false;
+  }
+  if (!S->isLoadStream() && !S->isAtomicComputeStream()) {
+    return false;
+  }
+  if (S->addrBaseStreams.size() != 1) {
+    return false;
+  }
+  auto addrBaseS = *S->addrBaseStreams.begin();
+  if (!floatedMap.count(addrBaseS)) {
+    // AddrBaseStream is not floated.
+    StreamFloatPolicy::logStream(S)
+        << "[Not Float] due to unfloat addr base stream.\n"
+        << std::flush;
+    return false;
+  }
+  // Check if all ValueBaseStreams are floated.
+  for (auto valueBaseS : S->valueBaseStreams) {
+    if (!floatedMap.count(valueBaseS)) {
+      // ValueBaseStream is not floated.
+      StreamFloatPolicy::logStream(S)
+          << "[Not Float] due to unfloat value base stream.\n"
+          << std::flush;
+      return false;
     }
-    if (S->addrBaseStreams.size() != 1) {
-      continue;
+  }
+  /**
+   * Multi-level indirection (e.g. A[B[C[i]]]) is limited to plain
+   * IndirectLoadStream, which is issued by the bank receiving the base
+   * element. RangeSync is not supported yet.
+   */
+  if (addrBaseS->isIndirectLoadStream()) {
+    if (!this->se->myParams->enableFloatMultiLevelIndirect) {
+      StreamFloatPolicy::logStream(S)
+          << "[Not Float] as multi-level indirect is disabled.\n"
+          << std::flush;
+      return false;
     }
-    auto addrBaseS = *S->addrBaseStreams.begin();
-    if (!floatedMap.count(addrBaseS)) {
-      // AddrBaseStream is not floated.
+    if (!S->isLoadStream() || S->isUpdateStream() ||
+        S->isLoadComputeStream()) {
       StreamFloatPolicy::logStream(S)
-          << "[Not Float] due to unfloat addr base stream.\n"
+          << "[Not Float] as multi-level indirect is not plain load.\n"
           << std::flush;
-      continue;
+      return false;
     }
-    // Check if all ValueBaseStreams are floated.
-    for (auto valueBaseS : S->valueBaseStreams) {
-      if (!floatedMap.count(valueBaseS)) {
-        // ValueBaseStream is not floated.
-        StreamFloatPolicy::logStream(S)
-            << "[Not Float] due to unfloat value base stream.\n"
-            << std::flush;
-        continue;
-      }
+    if (this->se->isStreamRangeSyncEnabled()) {
+      StreamFloatPolicy::logStream(S)
+          << "[Not Float] as multi-level indirect with RangeSync.\n"
+          << std::flush;
+      return false;
     }
-    /**
-     * Check if there is an aliased StoreStream for this LoadStream, but
-     * is not promoted into an UpdateStream.
-     */
+  }
+  /**
+   * Check if there is an aliased StoreStream for this LoadStream, but
+   * is not promoted into an UpdateStream.
+   */
+  StreamFloatPolicy::logStream(S)
+      << "HasAliasedStore " << S->aliasBaseStream->hasAliasedStoreStream
+      << " IsLoad " << S->isLoadStream() << " IsUpdate "
+      << S->isUpdateStream() << ".\n"
+      << std::flush;
+  if (S->aliasBaseStream->hasAliasedStoreStream && S->isLoadStream() &&
+      !S->isUpdateStream()) {
     StreamFloatPolicy::logStream(S)
-        << "HasAliasedStore " << S->aliasBaseStream->hasAliasedStoreStream
-        << " IsLoad " << S->isLoadStream() << " IsUpdate "
-        << S->isUpdateStream() << ".\n"
+        << "[Not Float] due to aliased store stream.\n"
         << std::flush;
-    if (S->aliasBaseStream->hasAliasedStoreStream && S->isLoadStream() &&
-        !S->isUpdateStream()) {
-      StreamFloatPolicy::logStream(S)
-          << "[Not Float] due to aliased store stream.\n"
-          << std::flush;
+    return false;
+  }
+  auto baseConfig = floatedMap.at(addrBaseS);
+  // Only dependent on this base stream.
+  auto config = S->allocateCacheConfigureData(dynS->configSeqNum,
+                                              true /* isIndirect */);
+  baseConfig->addUsedBy(config);
+  // Add SendTo edges if the ValueBaseStream is not my AddrBaseStream.
+  for (auto valueBaseS : S->valueBaseStreams) {
+    if (valueBaseS == addrBaseS) {
       continue;
     }
-    auto baseConfig = floatedMap.at(addrBaseS);
-    // Only dependent on this direct stream.
-    auto config = S->allocateCacheConfigureData(dynS->configSeqNum,
-                                                true /* isIndirect */);
-    baseConfig->addUsedBy(config);
-    // Add SendTo edges if the ValueBaseStream is not my AddrBaseStream.
-    for (auto valueBaseS : S->valueBaseStreams) {
-      if (valueBaseS == addrBaseS) {
-        continue;
-      }
-      auto &valueBaseConfig = floatedMap.at(valueBaseS);
-      valueBaseConfig->addSendTo(config);
-      config->addBaseOn(valueBaseConfig);
-    }
-    DYN_S_DPRINTF(dynS->dynamicStreamId, "Offload as indirect.\n");
-    StreamFloatPolicy::logStream(S) << "[Float] as indirect.\n" << std::flush;
-    floatedMap.emplace(S, config);
-    if (S->getEnabledStoreFunc()) {
-      if (!dynS->hasTotalTripCount()) {
-        DYN_S_PANIC(dynS->dynamicStreamId,
-                    "ComputeStream without TotalTripCount writes to memory.");
-      }
+    auto &valueBaseConfig = floatedMap.at(valueBaseS);
+    valueBaseConfig->addSendTo(config);
+    config->addBaseOn(valueBaseConfig);
+  }
+  DYN_S_DPRINTF(dynS->dynamicStreamId, "Offload as indirect.\n");
+  StreamFloatPolicy::logStream(S) << "[Float] as indirect.\n" << std::flush;
+  floatedMap.emplace(S, config);
+  if (S->getEnabledStoreFunc()) {
+    if (!dynS->hasTotalTripCount()) {
+      DYN_S_PANIC(dynS->dynamicStreamId,
+                  "ComputeStream without TotalTripCount writes to memory.");
     }
   }
+  return true;
 }
 
 void StreamFloatController::floatDirectStoreComputeOrUpdateStreams(
@@ -591,6 +718,9 @@ void StreamFloatController::floatDirectOrPointerChaseReductionStreams(
     if (backBaseStreamConfigs.empty()) {
       S_PANIC(S, "ReductionStream without BackBaseStream.");
     }
+    if (!this->canFloatPredicatedReduction(dynS)) {
+      continue;
+    }
     /**
      * We require has TotalTripCount, or at Least the base
      * stream has LoopBoundCallback.
@@ -648,7 +778,9 @@ void StreamFloatController::floatDirectOrPointerChaseReductionStreams(
     S_DPRINTF(S, "ReductionStream associated with %s, existing sender %d.\n",
               baseConfigWithMostSenders->dynamicId, maxSenders);
     StreamFloatPolicy::logStream(S)
-        << "[Float] as Reduction with " << baseConfigWithMostSenders->dynamicId
+        << (S->isMergeStream() ? "[Float] as Merge with "
+                               : "[Float] as Reduction with ")
+        << baseConfigWithMostSenders->dynamicId
         << ", existing # sender " << maxSenders << ".\n"
         << std::flush;
     for (int i = 0; i < backBaseStreamConfigs.size(); ++i) {
@@ -662,6 +794,82 @@ void StreamFloatController::floatDirectOrPointerChaseReductionStreams(
   }
 }
 
+void StreamFloatController::checkMergeStream(DynamicStream *dynS) {
+  auto S = dynS->stream;
+  if (!this->se->enableStreamFloat) {
+    S_FATAL(S, "MergeStream requires StreamFloat enabled.");
+  }
+  if (this->se->cpuDelegator->cpuType ==
+      GemForgeCPUDelegator::CPUTypeE::ATOMIC_SIMPLE) {
+    S_FATAL(S, "MergeStream is not supported in AtomicSimpleCPU.");
+  }
+  const auto &mergeStreams = S->getMergeStreams();
+  if (mergeStreams.size() != 2) {
+    S_FATAL(S, "MergeStream requires two key streams, got %d.",
+            mergeStreams.size());
+  }
+  for (const auto &mergeStreamId : mergeStreams) {
+    auto mergeS = this->se->getStream(mergeStreamId.id());
+    if (!S->backBaseStreams.count(mergeS)) {
+      S_FATAL(S, "MergeStream requires key stream %s as BackBaseStream.",
+              mergeS->getStreamName());
+    }
+    if (!mergeS->isDirectLoadStream()) {
+      S_FATAL(S, "MergeStream requires key stream %s as DirectLoadStream.",
+              mergeS->getStreamName());
+    }
+    if (mergeS->getCoreElementSize() > static_cast<int>(sizeof(uint64_t))) {
+      S_FATAL(S, "MergeStream requires key size <= %d, got %d from %s.",
+              sizeof(uint64_t), mergeS->getCoreElementSize(),
+              mergeS->getStreamName());
+    }
+  }
+  /**
+   * Only the keys are buffered in the LLC, so the reduce function can not
+   * take any other base stream: its value at the current element does not
+   * belong to the buffered keys being reduced.
+   */
+  for (auto baseS : S->backBaseStreams) {
+    if (baseS == S) {
+      continue;
+    }
+    bool isKeyStream = false;
+    for (const auto &mergeStreamId : mergeStreams) {
+      if (baseS->staticId == mergeStreamId.id()) {
+        isKeyStream = true;
+      }
+    }
+    if (!isKeyStream) {
+      S_FATAL(S, "MergeStream can only take the key streams, got %s.",
+              baseS->getStreamName());
+    }
+  }
+  /**
+   * The remaining keys are drained at the last element, so we have to know
+   * the trip count.
+   */
+  if (!dynS->hasTotalTripCount()) {
+    S_FATAL(S, "MergeStream requires TotalTripCount.");
+  }
+}
+
+bool StreamFloatController::canFloatPredicatedReduction(DynamicStream *dynS) {
+  auto S = dynS->stream;
+  if (!S->isPredicatedReduction()) {
+    return true;
+  }
+  if (!this->se->myParams->enableFloatPredicatedReduction) {
+    StreamFloatPolicy::logStream(S)
+        << "[Not Float] as PredicatedReduction is disabled.\n"
+        << std::flush;
+    return false;
+  }
+  if (!dynS->predCallback) {
+    S_PANIC(S, "PredicatedReduction without PredCallback.");
+  }
+  return true;
+}
+
 void StreamFloatController::floatIndirectReductionStream(const Args &args,
                                                          DynamicStream *dynS) {
   auto &floatedMap = args.floatedMap;
@@ -702,6 +910,9 @@ void StreamFloatController::floatIndirectReductionStream(const Args &args,
       backBaseDirectS = BS;
     }
   }
+  if (!this->canFloatPredicatedReduction(dynS)) {
+    return;
+  }
   if (!backBaseIndirectS) {
     S_DPRINTF(S, "Not an IndirectReductionStream to float.");
     return;
@@ -718,6 +929,19 @@ void StreamFloatController::floatIndirectReductionStream(const Args &args,
         << std::flush;
     return;
   }
+  /**
+   * IndirectReduction is only supported over one level of indirection.
+   * Reductions over chained indirect streams (e.g. A[B[C[i]]]) are left to
+   * the core.
+   */
+  for (auto addrBaseS : backBaseIndirectS->addrBaseStreams) {
+    if (addrBaseS->isIndirectLoadStream()) {
+      StreamFloatPolicy::logStream(S)
+          << "[Not Float] as IndirectReduction over chained indirect.\n"
+          << std::flush;
+      return;
+    }
+  }
   if (backBaseDirectS && !floatedMap.count(backBaseDirectS)) {
     StreamFloatPolicy::logStream(S)
         << "[Not Float] as BackBaseDirectStream is not floated.\n"
@@ -1003,6 +1227,59 @@ void StreamFloatController::propagateFloatPlan(const Args &args) {
   }
 }
 
+void StreamFloatController::decideParallelReductionStreams(const Args &args) {
+  if (!this->se->myParams->enableFloatParallelReduction) {
+    return;
+  }
+  for (auto dynS : args.dynStreams) {
+    auto S = dynS->stream;
+    auto iter = args.floatedMap.find(S);
+    if (iter == args.floatedMap.end() || !S->isReduction() ||
+        !S->addrBaseStreams.empty()) {
+      continue;
+    }
+    auto &config = iter->second;
+    if (S->isMergeStream()) {
+      // The merge walk is inherently serial.
+      continue;
+    }
+    bool allBackBaseStreamsAreDirect = true;
+    for (auto backBaseS : S->backBaseStreams) {
+      if (backBaseS != S && !backBaseS->isDirectMemStream()) {
+        allBackBaseStreamsAreDirect = false;
+        break;
+      }
+    }
+    if (!allBackBaseStreamsAreDirect) {
+      // Indirect and PointerChase reductions are not handled.
+      continue;
+    }
+    auto reduceOp = S->getAddrFuncComputeOp();
+    if (reduceOp != ::LLVM::TDG::ExecFuncInfo_ComputeOp_FLOAT_ADD &&
+        reduceOp != ::LLVM::TDG::ExecFuncInfo_ComputeOp_INT_ADD) {
+      StreamFloatPolicy::logStream(S)
+          << "[Not ParallelReduction] as ReduceOp is not distributable.\n"
+          << std::flush;
+      continue;
+    }
+    if (!config->depEdges.empty()) {
+      StreamFloatPolicy::logStream(S)
+          << "[Not ParallelReduction] as used by other floated streams.\n"
+          << std::flush;
+      continue;
+    }
+    if (dynS->getFloatPlan().isFloatedToMem()) {
+      StreamFloatPolicy::logStream(S)
+          << "[Not ParallelReduction] as floated to memory.\n"
+          << std::flush;
+      continue;
+    }
+    config->isParallelReduction = true;
+    StreamFloatPolicy::logStream(S) << "[ParallelReduction] Enabled.\n"
+                                    << std::flush;
+  }
+}
+
 void StreamFloatController::processMidwayFloat() {
   for (auto iter = this->configSeqNumToMidwayFloatPktMap.begin(),
             end = this->configSeqNumToMidwayFloatPktMap.end();
@@ -34,6 +34,14 @@ public:
    */
   void processMidwayFloat();
 
+  /**
+   * Check the runtime feedback of a floated stream.
+   * @return whether it should be sunk back to the core.
+   */
+  bool shouldSinkStream(DynamicStream &dynS) {
+    return this->policy->shouldSinkStream(dynS);
+  }
+
 private:
   StreamEngine *se;
   std::unique_ptr<StreamFloatPolicy> policy;
@@ -56,12 +64,22 @@ private:
           floatedMap(_floatedMap), rootConfigVec(_rootConfigVec) {}
   };
 
+  /**
+   * StreamNUCA online page migration is performed here, before any stream
+   * translates its initial address, and only when the system is quiesced.
+   */
+  void tryStreamNUCAOnlineMigration();
+  bool isQuiescedForStreamNUCAMigration(ThreadContext *tc) const;
+
   void floatDirectLoadStreams(const Args &args);
   void floatDirectAtomicComputeStreams(const Args &args);
   void floatPointerChaseStreams(const Args &args);
   void floatIndirectStreams(const Args &args);
+  bool floatIndirectStream(const Args &args, DynamicStream *dynS);
   void floatDirectStoreComputeOrUpdateStreams(const Args &args);
   void floatDirectOrPointerChaseReductionStreams(const Args &args);
+  void checkMergeStream(DynamicStream *dynS);
+  bool canFloatPredicatedReduction(DynamicStream *dynS);
   void floatIndirectReductionStreams(const Args &args);
   void floatIndirectReductionStream(const Args &args, DynamicStream *dynS);
   void floatTwoLevelIndirectStoreComputeStreams(const Args &args);
@@ -107,6 +125,12 @@ private:
    */
   void propagateFloatPlan(const Args &args);
 
+  /**
+   * Decide if floated DirectReductionStreams can be reduced in parallel at
+   * each LLC bank. This requires the FloatPlan.
+   */
+  void decideParallelReductionStreams(const Args &args);
+
   /**
    * Try send out a midway float pkt.
    */
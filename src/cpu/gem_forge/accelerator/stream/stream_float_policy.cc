@@ -51,8 +51,10 @@ std::vector<uint64_t> getCacheCapacity(StreamEngine *se) {
 
 StreamFloatPolicy::StreamFloatPolicy(bool _enabled, bool _enabledFloatMem,
                                      const std::string &_policy,
-                                     const std::string &_levelPolicy)
-    : enabled(_enabled), enabledFloatMem(_enabledFloatMem) {
+                                     const std::string &_levelPolicy,
+                                     const SinkThresholds &_sinkThresholds)
+    : enabled(_enabled), enabledFloatMem(_enabledFloatMem),
+      sinkThresholds(_sinkThresholds) {
   if (_policy == "static") {
     this->policy = PolicyE::STATIC;
   } else if (_policy == "manual") {
@@ -61,6 +63,8 @@ StreamFloatPolicy::StreamFloatPolicy(bool _enabled, bool _enabledFloatMem,
     this->policy = PolicyE::SMART;
   } else if (_policy == "smart-computation") {
     this->policy = PolicyE::SMART_COMPUTATION;
+  } else if (_policy == "adaptive") {
+    this->policy = PolicyE::ADAPTIVE;
   } else {
     panic("Invalid StreamFloatPolicy %s.", _policy);
   }
@@ -122,6 +126,17 @@ StreamFloatPolicy::shouldFloatStream(DynamicStream &dynS) {
       return FloatDecision();
     }
   }
+  /**
+   * LLC elements always take the full vector size and can not clamp the
+   * partial tail of a vector stream.
+   */
+  if (dynS.hasVectorTail()) {
+    S_DPRINTF(S, "[Not Float] VectorTailLanes %d.\n", dynS.vectorTailLanes);
+    logStream(S) << "[Not Float] VectorTailLanes " << dynS.vectorTailLanes
+                 << '\n'
+                 << std::flush;
+    return FloatDecision();
+  }
   /**
    * Make sure we do not offload empty stream.
    * This information may be known at configuration time, or even require
@@ -147,6 +162,9 @@ StreamFloatPolicy::shouldFloatStream(DynamicStream &dynS) {
   case PolicyE::SMART: {
     return this->shouldFloatStreamSmart(dynS);
   }
+  case PolicyE::ADAPTIVE: {
+    return this->shouldFloatStreamAdaptive(dynS);
+  }
   default: {
     return FloatDecision();
   }
@@ -412,6 +430,76 @@ StreamFloatPolicy::shouldFloatStreamSmart(DynamicStream &dynS) {
   return FloatDecision(true);
 }
 
+StreamFloatPolicy::FloatDecision
+StreamFloatPolicy::shouldFloatStreamAdaptive(DynamicStream &dynS) {
+  /**
+   * The last instance is sunk back to the core at runtime, which means it
+   * has good private cache locality. Keep it in the core. Once a later
+   * instance in the core misses in the private cache, checkAggregateHistory
+   * will float it again.
+   */
+  auto S = dynS.stream;
+  if (!S->aggregateHistory.empty() &&
+      S->aggregateHistory.back().floatCancelled) {
+    S_DPRINTF(S, "[Not Float] Sunk in last instance.\n");
+    logStream(S) << "[Not Float] Sunk in last instance.\n" << std::flush;
+    return FloatDecision(false);
+  }
+  return this->shouldFloatStreamSmart(dynS);
+}
+
+bool StreamFloatPolicy::shouldSinkStream(DynamicStream &dynS) {
+  if (this->policy != PolicyE::ADAPTIVE) {
+    return false;
+  }
+  /**
+   * Sink if most recent requests hit in the private cache, or a good part
+   * of them hit and the floated data is expensive: either mostly late
+   * (congested NoC or overloaded LLC SE), or from far away LLC banks.
+   */
+  const auto &thresholds = this->sinkThresholds;
+  auto S = dynS.stream;
+  auto hitRate = static_cast<float>(dynS.getTotalHitPrivateCache()) /
+                 static_cast<float>(dynS.getHitPrivateCacheHistoryWindowSize());
+  const auto &feedback = dynS.floatFeedback;
+  auto lateRatio = 0.0f;
+  if (feedback.numElements >= thresholds.minFeedbackElements) {
+    lateRatio = static_cast<float>(feedback.numLateElements) /
+                static_cast<float>(feedback.numElements);
+  }
+  auto avgHops = feedback.numHopSlices == 0
+                     ? 0.0f
+                     : static_cast<float>(feedback.numHops) /
+                           static_cast<float>(feedback.numHopSlices);
+  auto avgLateCycles =
+      feedback.numLateElements == 0
+          ? 0.0f
+          : static_cast<float>(feedback.numLateCycles) /
+                static_cast<float>(feedback.numLateElements);
+
+  bool shouldSink = false;
+  if (hitRate >= thresholds.hitRate) {
+    shouldSink = true;
+  } else if (hitRate >= thresholds.partialHitRate &&
+             (lateRatio >= thresholds.lateRatio ||
+              avgHops >= thresholds.avgHops)) {
+    shouldSink = true;
+  }
+  if (shouldSink) {
+    S_DPRINTF(S,
+              "[Sink] Elem %llu HitRate %f LateRatio %f AvgLateCycles %f "
+              "AvgHops %f.\n",
+              dynS.getNumReleasedElements(), hitRate, lateRatio, avgLateCycles,
+              avgHops);
+    logStream(S) << "[Sink] Elem " << dynS.getNumReleasedElements()
+                 << " HitRate " << hitRate << " LateRatio " << lateRatio
+                 << " AvgLateCycles " << avgLateCycles << " AvgHops "
+                 << avgHops << ".\n"
+                 << std::flush;
+  }
+  return shouldSink;
+}
+
 bool StreamFloatPolicy::shouldPseudoFloatStream(DynamicStream &dynS) {
   /**
    * So far we use simple heuristic:
@@ -7,9 +7,21 @@
 
 class StreamFloatPolicy {
 public:
+  /**
+   * Thresholds for the adaptive policy to sink a floated stream.
+   */
+  struct SinkThresholds {
+    float hitRate;
+    float partialHitRate;
+    float lateRatio;
+    float avgHops;
+    uint64_t minFeedbackElements;
+  };
+
   StreamFloatPolicy(bool _enabled, bool _enabledFloatMem,
                     const std::string &_policy,
-                    const std::string &_levelPolicy);
+                    const std::string &_levelPolicy,
+                    const SinkThresholds &_sinkThresholds);
   ~StreamFloatPolicy();
 
   struct FloatDecision {
@@ -21,6 +33,14 @@ public:
 
   bool shouldPseudoFloatStream(DynamicStream &dynS);
 
+  /**
+   * The adaptive policy monitors the floated stream at runtime and sinks it
+   * back to the core if the private cache serves it well, or the floated
+   * data arrives late from a far away or congested LLC bank.
+   * Always false for other policies.
+   */
+  bool shouldSinkStream(DynamicStream &dynS);
+
   static std::ostream &logStream(Stream *S);
 
   /**
@@ -36,11 +56,13 @@ public:
 private:
   bool enabled;
   bool enabledFloatMem;
+  const SinkThresholds sinkThresholds;
   enum PolicyE {
     STATIC,
     MANUAL,
     SMART,
     SMART_COMPUTATION,
+    ADAPTIVE,
   } policy;
   enum LevelPolicyE {
     LEVEL_STATIC,
@@ -55,6 +77,7 @@ private:
 
   FloatDecision shouldFloatStreamManual(DynamicStream &dynS);
   FloatDecision shouldFloatStreamSmart(DynamicStream &dynS);
+  FloatDecision shouldFloatStreamAdaptive(DynamicStream &dynS);
   bool checkReuseWithinStream(DynamicStream &dynS);
   bool checkAggregateHistory(DynamicStream &dynS);
 
@@ -12,6 +12,7 @@
 #define S_DPRINTF(S, format, args...) S_DPRINTF_(DEBUG_TYPE, S, format, ##args)
 #define S_HACK(S, format, args...) hack(S_MSG(S, format, ##args))
 #define S_PANIC(S, format, args...) panic(S_MSG(S, format, ##args))
+#define S_FATAL(S, format, args...) fatal(S_MSG(S, format, ##args))
 
 #define S_FIFO_ENTRY_MSG(E, format, args...) "%s: " format, (E), ##args
 #define S_FIFO_ENTRY_DPRINTF_(X, E, format, args...)                           \
@@ -53,6 +53,8 @@ void StreamStatistic::dump(std::ostream &os) const {
   dumpAvg(avgMaxSize, maxSize, numSample);
   dumpAvg(avgAllocSize, allocSize, numSample);
   dumpAvg(avgNumDynStreams, numDynStreams, numSample);
+  dumpScalarIfNonZero(numThrottleGrow);
+  dumpScalarIfNonZero(numThrottleShrink);
 
   dumpScalar(numMLCAllocatedSlice);
 
@@ -83,6 +85,14 @@ void StreamStatistic::dump(std::ostream &os) const {
     dumpSingleAvgSample(remoteForwardNoCDelay);
     dumpSingleAvgSample(remoteIndReqNoCDelay);
 
+    if (numLLCCompressedData > 0) {
+      dumpScalar(numLLCCompressedData);
+      dumpScalar(numLLCUncompressedBytes);
+      dumpScalar(numLLCCompressedBytes);
+      dumpAvg(llcCompressRatio, numLLCUncompressedBytes,
+              numLLCCompressedBytes);
+    }
+
     dumpScalar(numLLCAliveElementSamples);
     if (numLLCAliveElementSamples > 0) {
       dumpAvg(avgLLCAliveElements, numLLCAliveElements,
@@ -133,6 +143,13 @@ void StreamStatistic::dump(std::ostream &os) const {
     dumpAvg(avgLLCWaitComputeLatency, numLLCComputationWaitLatency,
             numLLCComputation);
   }
+  if (numLLCMergeComparison > 0) {
+    dumpScalar(numLLCMergeComparison);
+    dumpScalar(numLLCMergeMatch);
+  }
+  if (numLLCPredicatedReductionSkip > 0) {
+    dumpScalar(numLLCPredicatedReductionSkip);
+  }
 
   dumpScalar(numFloatAtomic);
   if (numFloatAtomic > 0) {
@@ -200,6 +217,7 @@ StreamStatistic::llcSEIssueReasonToString(LLCStreamEngineIssueReason reason) {
     Case(AliasedIndirectUpdate);
     Case(BaseValueNotReady);
     Case(ValueNotReady);
+    Case(StreamNUCAMigrate);
     Case(NumLLCStreamEngineIssueReason);
 #undef Case
   default:
@@ -230,6 +248,8 @@ void StreamStatistic::clear() {
   this->maxSize = 0;
   this->allocSize = 0;
   this->numDynStreams = 0;
+  this->numThrottleGrow = 0;
+  this->numThrottleShrink = 0;
   this->numMLCAllocatedSlice = 0;
   this->numLLCIssueSlice = 0;
   this->numLLCSentSlice = 0;
@@ -268,6 +288,9 @@ void StreamStatistic::clear() {
   this->numLLCComputation = 0;
   this->numLLCComputationComputeLatency = 0;
   this->numLLCComputationWaitLatency = 0;
+  this->numLLCMergeComparison = 0;
+  this->numLLCMergeMatch = 0;
+  this->numLLCPredicatedReductionSkip = 0;
   this->numFloatAtomic = 0;
   this->numFloatAtomicRecvCommitCycle = 0;
   this->numFloatAtomicWaitForCommitCycle = 0;
@@ -281,6 +304,9 @@ void StreamStatistic::clear() {
   this->numLLCAliveElementSamples = 0;
   this->numLLCInflyComputation = 0;
   this->numLLCInflyComputationSample = 0;
+  this->numLLCCompressedData = 0;
+  this->numLLCUncompressedBytes = 0;
+  this->numLLCCompressedBytes = 0;
 
   this->idealDataTrafficFix = 0;
   this->idealDataTrafficCached = 0;
@@ -42,6 +42,8 @@ public:
   size_t maxSize = 0;
   size_t allocSize = 0;
   size_t numDynStreams = 0;
+  size_t numThrottleGrow = 0;
+  size_t numThrottleShrink = 0;
 
   // Float statistics.
   size_t numMLCAllocatedSlice = 0;
@@ -107,6 +109,9 @@ public:
   size_t numLLCComputation = 0;
   size_t numLLCComputationComputeLatency = 0;
   size_t numLLCComputationWaitLatency = 0;
+  size_t numLLCMergeComparison = 0;
+  size_t numLLCMergeMatch = 0;
+  size_t numLLCPredicatedReductionSkip = 0;
   size_t numFloatAtomic = 0;
   size_t numFloatAtomicRecvCommitCycle = 0;
   size_t numFloatAtomicWaitForCommitCycle = 0;
@@ -120,6 +125,16 @@ public:
         .first->second++;
   }
 
+  // Stream data compressed by LLC before sending to MLC/LLC.
+  size_t numLLCCompressedData = 0;
+  size_t numLLCUncompressedBytes = 0;
+  size_t numLLCCompressedBytes = 0;
+  void sampleLLCCompressedData(int uncompressedBytes, int compressedBytes) {
+    this->numLLCCompressedData++;
+    this->numLLCUncompressedBytes += uncompressedBytes;
+    this->numLLCCompressedBytes += compressedBytes;
+  }
+
   size_t numLLCInflyComputationSample = 0;
   size_t numLLCInflyComputation = 0;
   void sampleLLCInflyComputation(int inflyComputation) {
@@ -147,6 +162,7 @@ public:
     AliasedIndirectUpdate,
     BaseValueNotReady,
     ValueNotReady,
+    StreamNUCAMigrate,
     NumLLCStreamEngineIssueReason,
   };
   // Will be default initialized.
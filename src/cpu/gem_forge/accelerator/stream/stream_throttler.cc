@@ -1,4 +1,5 @@
 #include "stream_throttler.hh"
+#include "stream_event_tracer.hh"
 
 #include "debug/StreamThrottle.hh"
 
@@ -12,9 +13,17 @@ StreamThrottler::StreamThrottler(const std::string &_strategy,
     this->strategy = StrategyE::STATIC;
   } else if (_strategy == "dynamic") {
     this->strategy = StrategyE::DYNAMIC;
+  } else if (_strategy == "utility") {
+    this->strategy = StrategyE::UTILITY;
   } else {
     this->strategy = StrategyE::GLOBAL;
   }
+  const auto *params = this->se->myParams;
+  this->maxSizeForOuterLoopStream = params->throttlingMaxSizeForOuterLoopStream;
+  this->utilityEpochCycles = params->throttlingUtilityEpochCycles;
+  this->utilityIdleCycles = params->throttlingUtilityIdleCycles;
+  this->utilityMinEpochSamples = params->throttlingUtilityMinEpochSamples;
+  this->utilityIdleRatio = params->throttlingUtilityIdleRatio;
 }
 
 const std::string StreamThrottler::name() const { return this->se->name(); }
@@ -41,6 +50,10 @@ void StreamThrottler::throttleStream(StreamElement *element) {
     // No valid cycle record, do nothing.
     return;
   }
+  if (this->strategy == StrategyE::UTILITY) {
+    this->sampleUtility(element);
+    return;
+  }
   if (element->valueReadyCycle < element->firstValueCheckCycle + Cycles(2)) {
     // The element is ready earlier than user, do nothing.
     // We add 2 cycles buffer here.
@@ -161,11 +174,11 @@ bool StreamThrottler::tryGlobalThrottle(Stream *S) {
       return false;
     }
   }
-  int MaxSizeForOuterLoopStream = 8;
-  if (!S->getIsInnerMostLoop() && S->maxSize >= MaxSizeForOuterLoopStream) {
+  if (!S->getIsInnerMostLoop() &&
+      S->maxSize >= this->maxSizeForOuterLoopStream) {
     S_DPRINTF(S,
               "[Not Throttle] MyMaxSize %d >= %d MaxSizeForOuterLoopStream.\n",
-              S->maxSize, MaxSizeForOuterLoopStream);
+              S->maxSize, this->maxSizeForOuterLoopStream);
     return false;
   }
 
@@ -258,6 +271,209 @@ bool StreamThrottler::tryGlobalThrottle(Stream *S) {
   return true;
 }
 
+/********************************************************************
+ * Utility-based throttling.
+ *
+ * Instead of growing one step group at a time when it is late, we
+ * periodically redistribute the whole FIFO among the configured step
+ * groups according to how much they benefit from running ahead.
+ *
+ * Every group keeps its FloorEntries per stream, the same as the initial
+ * MaxSize assigned in StreamEngine::initializeStreams, so that shrinking
+ * never starves a stream. BasicEntries of the alive streams that are not
+ * configured yet are also reserved. The rest of the FIFO entries and
+ * run ahead bytes are the pool.
+ *
+ * The utility of a group is the smoothed ratio of late elements:
+ * * Utility = (Utility + LateElements / SampledElements) / 2.
+ * A group with no late element and mostly idle elements, i.e. ready
+ * long before the user, is latency tolerant and its utility drops to 0.
+ *
+ * The pool is handed out one entry per stream at a time to the group with
+ * the highest marginal utility, Utility / (1 + ExtraEntries), subject to
+ * the same upper bounds as GLOBAL throttling. A group with 0 utility gets
+ * no extra entries and shrinks back to FloorEntries.
+ ********************************************************************/
+
+void StreamThrottler::sampleUtility(StreamElement *element) {
+  auto S = element->stream;
+  // Elements ready utilityIdleCycles before the user sat idle in the FIFO.
+  S->throttleSampleCount++;
+  if (element->valueReadyCycle >= element->firstValueCheckCycle + Cycles(2)) {
+    S->lateFetchCount++;
+  } else if (element->valueReadyCycle + this->utilityIdleCycles <
+             element->firstValueCheckCycle) {
+    S->idleFetchCount++;
+  }
+  auto curCycle = this->se->curCycle();
+  if (curCycle >= this->lastUtilityEpochCycle + this->utilityEpochCycles) {
+    this->lastUtilityEpochCycle = curCycle;
+    this->redistributeByUtility();
+  }
+}
+
+void StreamThrottler::redistributeByUtility() {
+  struct StepGroup {
+    Stream *stepRootS;
+    const std::list<Stream *> *streams;
+    int floorEntries;
+    int upperBoundEntries;
+    int bytesPerEntry = 0;
+    int extraEntries = 0;
+  };
+
+  // Collect the step groups and the entries not managed by us.
+  std::vector<StepGroup> groups;
+  int currentAliveStreams = 0;
+  int totalAliveStreams = 0;
+  int fixedEntries = 0;
+  int fixedBytes = 0;
+  for (const auto &IdStream : this->se->streamMap) {
+    auto S = IdStream.second;
+    if (!S->isConfigured()) {
+      continue;
+    }
+    currentAliveStreams++;
+    auto streamRegion = S->streamRegion;
+    totalAliveStreams =
+        std::max(totalAliveStreams,
+                 this->se->enableCoalesce
+                     ? streamRegion->total_alive_coalesced_streams()
+                     : streamRegion->total_alive_streams());
+    if (S->stepRootStream == S) {
+      groups.emplace_back();
+      auto &group = groups.back();
+      group.stepRootS = S;
+      group.streams = &this->se->getStepStreamList(S);
+    } else if (S->stepRootStream == nullptr) {
+      // Constant streams are not throttled.
+      fixedEntries += S->maxSize;
+      if (S->isLoadStream()) {
+        fixedBytes +=
+            S->maxSize * S->getLastDynamicStream().getBytesPerMemElement();
+      }
+    }
+  }
+  if (groups.empty()) {
+    return;
+  }
+
+  int floorEntries =
+      std::min(static_cast<int>(this->se->defaultRunAheadLength),
+               this->se->totalRunAheadLength /
+                   std::max(totalAliveStreams, currentAliveStreams));
+  int basicEntries = std::max(totalAliveStreams, currentAliveStreams) *
+                     this->se->defaultRunAheadLength;
+  int reservedEntries = std::max(0, totalAliveStreams - currentAliveStreams) *
+                        this->se->defaultRunAheadLength;
+  int availableEntries =
+      this->se->totalRunAheadLength - fixedEntries - reservedEntries;
+  int availableBytes = this->se->totalRunAheadBytes - fixedBytes;
+
+  // Update the utility and the floor of each group.
+  for (auto &group : groups) {
+    int sampled = 0;
+    int late = 0;
+    int idle = 0;
+    bool hugeElement = false;
+    for (auto S : *group.streams) {
+      sampled += S->throttleSampleCount;
+      late += S->lateFetchCount;
+      idle += S->idleFetchCount;
+      S->throttleSampleCount = 0;
+      S->lateFetchCount = 0;
+      S->idleFetchCount = 0;
+      size_t memElementSize = S->getMemElementSize();
+      if (memElementSize >= this->se->cpuDelegator->cacheLineSize() * 8) {
+        hugeElement = true;
+      }
+      if (S->isLoadStream()) {
+        group.bytesPerEntry +=
+            S->getLastDynamicStream().getBytesPerMemElement();
+      }
+    }
+    auto stepRootS = group.stepRootS;
+    if (sampled >= this->utilityMinEpochSamples) {
+      auto lateRatio = static_cast<float>(late) / static_cast<float>(sampled);
+      if (late == 0 &&
+          static_cast<float>(idle) >=
+              this->utilityIdleRatio * static_cast<float>(sampled)) {
+        stepRootS->throttleUtility = 0.0f;
+      } else {
+        stepRootS->throttleUtility =
+            (stepRootS->throttleUtility + lateRatio) * 0.5f;
+      }
+    }
+    int groupSize = group.streams->size();
+    if (hugeElement) {
+      // Keep the huge streams as they are, see StreamEngine.
+      group.floorEntries = stepRootS->maxSize;
+      group.upperBoundEntries = stepRootS->maxSize;
+    } else {
+      group.floorEntries = floorEntries;
+      group.upperBoundEntries =
+          (this->se->totalRunAheadLength - basicEntries) / groupSize +
+          this->se->defaultRunAheadLength;
+      if (!stepRootS->getIsInnerMostLoop()) {
+        group.upperBoundEntries =
+            std::min(group.upperBoundEntries, this->maxSizeForOuterLoopStream);
+      }
+      group.upperBoundEntries =
+          std::max(group.upperBoundEntries, group.floorEntries);
+    }
+    availableEntries -= group.floorEntries * groupSize;
+    availableBytes -= group.floorEntries * group.bytesPerEntry;
+  }
+
+  // Greedily hand out the pool by marginal utility.
+  while (true) {
+    StepGroup *bestGroup = nullptr;
+    float bestUtility = 0.0f;
+    for (auto &group : groups) {
+      int groupSize = group.streams->size();
+      if (group.floorEntries + group.extraEntries + 1 >
+              group.upperBoundEntries ||
+          groupSize > availableEntries ||
+          group.bytesPerEntry > availableBytes) {
+        continue;
+      }
+      auto utility = group.stepRootS->throttleUtility /
+                     static_cast<float>(1 + group.extraEntries);
+      if (utility > bestUtility) {
+        bestUtility = utility;
+        bestGroup = &group;
+      }
+    }
+    if (!bestGroup) {
+      break;
+    }
+    bestGroup->extraEntries++;
+    availableEntries -= bestGroup->streams->size();
+    availableBytes -= bestGroup->bytesPerEntry;
+  }
+
+  // Apply the new budget.
+  for (const auto &group : groups) {
+    size_t newMaxSize = group.floorEntries + group.extraEntries;
+    for (auto S : *group.streams) {
+      if (S->maxSize == newMaxSize) {
+        continue;
+      }
+      S_DPRINTF(S, "[Throttle] Utility %f MaxSize %d -> %d.\n",
+                group.stepRootS->throttleUtility, S->maxSize, newMaxSize);
+      if (newMaxSize > S->maxSize) {
+        S->statistic.numThrottleGrow++;
+      } else {
+        S->statistic.numThrottleShrink++;
+      }
+      S->maxSize = newMaxSize;
+      StreamEventTracer::trace(StreamEventTracer::CoreThrottle,
+                               S->getLastDynamicStream().dynamicStreamId,
+                               newMaxSize);
+    }
+  }
+}
+
 void StreamThrottler::boostStreams(const Stream::StreamVec &stepRootStreams) {
   if (this->strategy != StrategyE::GLOBAL) {
     // No boost unless we have GLOBAL throttling.
@@ -14,6 +14,7 @@ public:
     STATIC,
     DYNAMIC,
     GLOBAL,
+    UTILITY,
   };
   StrategyE strategy;
   StreamEngine *se;
@@ -29,7 +30,24 @@ public:
   void boostStreams(const Stream::StreamVec &stepRootStreams);
 
 private:
+  /**
+   * Outer loop streams are not throttled beyond this maxSize.
+   */
+  int maxSizeForOuterLoopStream;
+
   bool tryGlobalThrottle(Stream *S);
+
+  /**
+   * Utility-based throttling: sample each released element, and
+   * redistribute the run ahead budget every utilityEpochCycles.
+   */
+  Cycles utilityEpochCycles;
+  Cycles utilityIdleCycles;
+  int utilityMinEpochSamples;
+  float utilityIdleRatio;
+  Cycles lastUtilityEpochCycle = Cycles(0);
+  void sampleUtility(StreamElement *element);
+  void redistributeByUtility();
 };
 
 #endif
\ No newline at end of file
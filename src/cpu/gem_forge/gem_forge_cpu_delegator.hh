@@ -118,6 +118,28 @@ public:
    */
   virtual void recordStatsForFakeExecutedInst(const StaticInstPtr &inst) = 0;
 
+  /**
+   * GemForge changed some state that canExecute() depends on, e.g. a stream
+   * element's value is ready. A CPU that stops checking instructions failed
+   * canExecute() should check them again. By default the CPU keeps polling
+   * canExecute() and there is nothing to do.
+   */
+  virtual void wakeupGemForgeInsts() {}
+
+  /**
+   * Whether the CPU has no memory access in flight, i.e. nothing holds a
+   * translated paddr that may be remapped (used by StreamNUCA online page
+   * migration). Conservatively false for CPUs that cannot tell.
+   */
+  virtual bool isMemQuiesced() const { return false; }
+
+  /**
+   * Max number of instructions between dispatch and commit, e.g. the ROB
+   * size. Used to size the per-instruction states in GemForge. Simple CPUs
+   * only have one instruction in flight.
+   */
+  virtual int getMaxInflyInsts() const { return 1; }
+
   BaseCPU *baseCPU;
 
   /**
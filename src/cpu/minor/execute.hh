@@ -335,6 +335,11 @@ class Execute : public Named
     /** To allow ExecContext to find the LSQ */
     LSQ &getLSQ() { return lsq; }
 
+    /** Max number of issued but not yet committed instructions, i.e. the
+     *  capacity of the inFlightInsts queue */
+    unsigned int getMaxInFlightInsts() const
+    { return executeInfo[0].inFlightInsts->totalSpace(); }
+
     /** Does the given instruction have the right stream sequence number
      *  to be committed? */
     bool instIsRightStream(MinorDynInstPtr inst);
@@ -612,6 +612,14 @@ bool MinorCPUDelegator::translateVAddrOracle(Addr vaddr, Addr &paddr) {
   return true;
 }
 
+bool MinorCPUDelegator::isMemQuiesced() const {
+  return pimpl->cpu->pipeline->execute.getLSQ().isDrained();
+}
+
+int MinorCPUDelegator::getMaxInflyInsts() const {
+  return pimpl->cpu->pipeline->execute.getMaxInFlightInsts();
+}
+
 void MinorCPUDelegator::sendRequest(PacketPtr pkt) {
   // If this is not a load request, we should send immediately.
   // e.g. StreamConfig/End packet.
@@ -41,6 +41,8 @@ public:
   const std::string &getTraceExtraFolder() const override;
   bool translateVAddrOracle(Addr vaddr, Addr &paddr) override;
   void sendRequest(PacketPtr pkt) override;
+  bool isMemQuiesced() const override;
+  int getMaxInflyInsts() const override;
 
   /**
    * Interface to the CPU.
@@ -110,6 +110,9 @@ class DerivO3CPU(BaseCPU):
               "to the IEW stage)")
     dispatchWidth = Param.Unsigned(8, "Dispatch width")
     issueWidth = Param.Unsigned(8, "Issue width")
+    gemForgeWakeupLatency = Param.Cycles(1, "Latency from GemForge "
+              "waking up an instruction (e.g. stream value ready) to it "
+              "being ready to issue")
     wbWidth = Param.Unsigned(8, "Writeback width")
     fuPool = Param.FUPool(DefaultFUPool(), "Functional Unit pool")
 
@@ -237,6 +237,13 @@ class InstructionQueue
      */
     void rescheduleGemForgeInst(const DynInstPtr &resched_inst);
 
+    /**
+     * GemForge signals that some waiting GemForge instructions may be able
+     * to execute now. They are moved back to the ready list after
+     * gemForgeWakeupLatency cycles.
+     */
+    void scheduleGemForgeWakeup();
+
     /**
      * Reschedules a memory instruction. It will be ready to issue once
      * replayMemInst() is called.
@@ -335,6 +342,13 @@ class InstructionQueue
      */
     std::list<DynInstPtr> retryMemInsts;
 
+    /** List of GemForge instructions that are ready but failed
+     *  canExecute(), e.g. a StreamLoad whose element value is not ready.
+     *  Instead of polling them every cycle at the head of the ready list,
+     *  they wait here until GemForge wakes them up.
+     */
+    std::list<DynInstPtr> gemForgeWaitingInsts;
+
     /**
      * Struct for comparing entries to be added to the priority queue.
      * This gives reverse ordering to the instructions in terms of
@@ -443,6 +457,17 @@ class InstructionQueue
      */
     Cycles commitToIEWDelay;
 
+    /** Cycles from a GemForge wakeup to the waiting instructions being
+     *  back on the ready list, similar to the register wakeup latency.
+     */
+    Cycles gemForgeWakeupLatency;
+
+    /** Moves waiting GemForge instructions back to the ready list. */
+    EventFunctionWrapper gemForgeWakeupEvent;
+
+    /** Wakes up all the waiting GemForge instructions. */
+    void wakeGemForgeInsts();
+
     /** The sequence number of the squashed instruction. */
     InstSeqNum squashedSeqNum[Impl::MaxThreads];
 
@@ -507,6 +532,12 @@ class InstructionQueue
     /** Stat for number of non-speculative instructions removed due to a squash.
      */
     Stats::Scalar iqSquashedNonSpecRemoved;
+    /** Stat for number of GemForge instructions that failed canExecute()
+     *  and waited for a wakeup.
+     */
+    Stats::Scalar iqGemForgeInstsWaited;
+    /** Stat for number of GemForge wakeups. */
+    Stats::Scalar iqGemForgeWakeups;
     // Also include number of instructions rescheduled and replayed.
 
     /** Distribution of number of instructions in the queue.
@@ -90,7 +90,10 @@ InstructionQueue<Impl>::InstructionQueue(O3CPU *cpu_ptr, IEW *iew_ptr,
       iqPolicy(params->smtIQPolicy),
       numEntries(params->numIQEntries),
       totalWidth(params->issueWidth),
-      commitToIEWDelay(params->commitToIEWDelay)
+      commitToIEWDelay(params->commitToIEWDelay),
+      gemForgeWakeupLatency(params->gemForgeWakeupLatency),
+      gemForgeWakeupEvent([this]{ wakeGemForgeInsts(); },
+                          cpu_ptr->name() + ".iq.gemForgeWakeup")
 {
     assert(fuPool);
 
@@ -158,6 +161,8 @@ InstructionQueue<Impl>::InstructionQueue(O3CPU *cpu_ptr, IEW *iew_ptr,
 template <class Impl>
 InstructionQueue<Impl>::~InstructionQueue()
 {
+    if (gemForgeWakeupEvent.scheduled())
+        cpu->deschedule(gemForgeWakeupEvent);
     dependGraph.reset();
 #ifdef DEBUG
     cprintf("Nodes traversed: %i, removed: %i\n",
@@ -238,6 +243,17 @@ InstructionQueue<Impl>::regStats()
         .name(name() + ".iqSquashedNonSpecRemoved")
         .desc("Number of squashed non-spec instructions that were removed")
         .prereq(iqSquashedNonSpecRemoved);
+
+    iqGemForgeInstsWaited
+        .name(name() + ".iqGemForgeInstsWaited")
+        .desc("Number of GemForge instructions waiting for wakeup after "
+              "failing canExecute")
+        .prereq(iqGemForgeInstsWaited);
+
+    iqGemForgeWakeups
+        .name(name() + ".iqGemForgeWakeups")
+        .desc("Number of wakeups of waiting GemForge instructions")
+        .prereq(iqGemForgeWakeups);
 /*
     queueResDist
         .init(Num_OpClasses, 0, 99, 2)
@@ -426,6 +442,9 @@ InstructionQueue<Impl>::resetState()
     deferredMemInsts.clear();
     blockedMemInsts.clear();
     retryMemInsts.clear();
+    gemForgeWaitingInsts.clear();
+    if (gemForgeWakeupEvent.scheduled())
+        cpu->deschedule(gemForgeWakeupEvent);
     wbOutstanding = 0;
 }
 
@@ -458,6 +477,7 @@ InstructionQueue<Impl>::isDrained() const
 {
     bool drained = dependGraph.empty() &&
                    instsToExecute.empty() &&
+                   gemForgeWaitingInsts.empty() &&
                    wbOutstanding == 0;
     for (ThreadID tid = 0; tid < numThreads; ++tid)
         drained = drained && memDepUnit[tid].isDrained();
@@ -471,6 +491,7 @@ InstructionQueue<Impl>::drainSanityCheck() const
 {
     assert(dependGraph.empty());
     assert(instsToExecute.empty());
+    assert(gemForgeWaitingInsts.empty());
     for (ThreadID tid = 0; tid < numThreads; ++tid)
         memDepUnit[tid].drainSanityCheck();
 }
@@ -854,8 +875,28 @@ InstructionQueue<Impl>::scheduleReadyInsts()
 
         if (cpu->cpuDelegator) {
             if (!cpu->cpuDelegator->canExecute(issuing_inst)) {
-                DPRINTF(IQ, "GemForge cannot execute: %s.\n", *issuing_inst);
-                ++order_it;
+                /**
+                 * Do not poll it at the head of the ready list every cycle,
+                 * which also blocks younger insts of the same op class.
+                 * Park it until GemForge wakes it up.
+                 */
+                DPRINTF(IQ, "GemForge cannot execute, wait for wakeup: %s.\n",
+                        *issuing_inst);
+
+                readyInsts[op_class].pop();
+
+                if (!readyInsts[op_class].empty()) {
+                    moveToYoungerInst(order_it);
+                } else {
+                    readyIt[op_class] = listOrder.end();
+                    queueOnList[op_class] = false;
+                }
+
+                listOrder.erase(order_it++);
+
+                gemForgeWaitingInsts.push_back(issuing_inst);
+                ++iqGemForgeInstsWaited;
+
                 continue;
             }
         }
@@ -1141,6 +1182,43 @@ InstructionQueue<Impl>::rescheduleGemForgeInst(
     this->addIfReady(resched_inst);
 }
 
+template <class Impl>
+void
+InstructionQueue<Impl>::scheduleGemForgeWakeup()
+{
+    // Multiple signals before the wakeup are merged.
+    if (!gemForgeWakeupEvent.scheduled()) {
+        cpu->schedule(gemForgeWakeupEvent,
+                      cpu->clockEdge(gemForgeWakeupLatency));
+    }
+}
+
+template <class Impl>
+void
+InstructionQueue<Impl>::wakeGemForgeInsts()
+{
+    if (gemForgeWaitingInsts.empty()) {
+        return;
+    }
+
+    DPRINTF(IQ, "Waking up %d GemForge insts.\n",
+            gemForgeWaitingInsts.size());
+    ++iqGemForgeWakeups;
+
+    /**
+     * Simply move all of them back to the ready list. Those still not
+     * able to execute will fail canExecute() again and come back here.
+     */
+    for (const auto &inst : gemForgeWaitingInsts) {
+        addReadyMemInst(inst);
+    }
+    gemForgeWaitingInsts.clear();
+
+    // The CPU may be sleeping as nothing was ready.
+    cpu->wakeCPU();
+    cpu->activityThisCycle();
+}
+
 template <class Impl>
 void
 InstructionQueue<Impl>::rescheduleMemInst(const DynInstPtr &resched_inst)
@@ -1254,6 +1332,12 @@ InstructionQueue<Impl>::squash(ThreadID tid)
 
     doSquash(tid);
 
+    // Squashed GemForge insts are no longer waiting for wakeup.
+    gemForgeWaitingInsts.remove_if([this, tid](const DynInstPtr &inst) {
+        return inst->threadNumber == tid &&
+               inst->seqNum > squashedSeqNum[tid];
+    });
+
     // Also tell the memory dependence unit to squash.
     memDepUnit[tid].squash(squashedSeqNum[tid], tid);
 }
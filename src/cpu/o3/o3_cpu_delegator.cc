@@ -826,6 +826,22 @@ void DefaultO3CPUDelegator<CPUImpl>::recordStatsForFakeExecutedInst(
   }
 }
 
+template <class CPUImpl>
+void DefaultO3CPUDelegator<CPUImpl>::wakeupGemForgeInsts() {
+  pimpl->cpu->iew.instQueue.scheduleGemForgeWakeup();
+}
+
+template <class CPUImpl>
+bool DefaultO3CPUDelegator<CPUImpl>::isMemQuiesced() const {
+  return pimpl->cpu->iew.ldstQueue.isDrained();
+}
+
+template <class CPUImpl>
+int DefaultO3CPUDelegator<CPUImpl>::getMaxInflyInsts() const {
+  // Only single thread is supported.
+  return pimpl->cpu->rob.getMaxEntries(0);
+}
+
 #undef INST_PANIC
 #undef INST_DPRINTF
 
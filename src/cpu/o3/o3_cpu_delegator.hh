@@ -73,6 +73,9 @@ public:
   bool translateVAddrOracle(Addr vaddr, Addr &paddr) override;
   void sendRequest(PacketPtr pkt) override;
   void recordStatsForFakeExecutedInst(const StaticInstPtr &inst) override;
+  void wakeupGemForgeInsts() override;
+  bool isMemQuiesced() const override;
+  int getMaxInflyInsts() const override;
 
   /***************************************************************
    * Interface to the CPU.
@@ -170,6 +170,8 @@ Network::MessageSizeType_to_int(MessageSizeType size_type)
         return m_control_msg_size + 8;
       case MessageSizeType_Response_Data_16B:
         return m_control_msg_size + 16;
+      case MessageSizeType_Response_Data_32B:
+        return m_control_msg_size + 32;
       default:
         panic("Invalid range for type MessageSizeType");
         break;
@@ -53,7 +53,7 @@ using namespace std;
  */
 
 GarnetNetwork::GarnetNetwork(const Params *p)
-    : Network(p)
+    : Network(p), m_hop_latency(0)
 {
     m_num_rows = p->num_rows;
     m_ni_flit_size = p->ni_flit_size;
@@ -66,6 +66,7 @@ GarnetNetwork::GarnetNetwork(const Params *p)
     if (m_enable_fault_model)
         fault_model = p->fault_model;
     m_enable_multicast = p->enable_multicast;
+    m_multicast_in_router = p->multicast_in_router;
 
     m_vnet_type.resize(m_virtual_networks);
 
@@ -76,6 +77,37 @@ GarnetNetwork::GarnetNetwork(const Params *p)
             m_vnet_type[i] = CTRL_VNET_; // carries only ctrl packets
     }
 
+    // Per vnet flit size and VCs.
+    fatal_if(!p->vnet_flit_size.empty() &&
+             p->vnet_flit_size.size() != m_virtual_networks,
+             "vnet_flit_size should have %d entries.", m_virtual_networks);
+    fatal_if(!p->vnet_vcs.empty() &&
+             p->vnet_vcs.size() != m_virtual_networks,
+             "vnet_vcs should have %d entries.", m_virtual_networks);
+    m_vnet_flit_size = p->vnet_flit_size;
+    m_vnet_flit_size.resize(m_virtual_networks, m_ni_flit_size);
+    m_vnet_vcs = p->vnet_vcs;
+    m_vnet_vcs.resize(m_virtual_networks, m_vcs_per_vnet);
+
+    m_bulk_data_vnet = p->bulk_data_vnet;
+    if (m_bulk_data_vnet >= 0) {
+        fatal_if(m_bulk_data_vnet >= (int)m_virtual_networks,
+                 "Illegal bulk data vnet %d.", m_bulk_data_vnet);
+        m_vnet_type[m_bulk_data_vnet] = DATA_VNET_;
+        m_vnet_flit_size[m_bulk_data_vnet] = p->bulk_data_flit_size;
+        if (p->bulk_data_vcs > 0) {
+            m_vnet_vcs[m_bulk_data_vnet] = p->bulk_data_vcs;
+        }
+    }
+
+    for (int i = 0; i < m_virtual_networks; i++) {
+        fatal_if(m_vnet_flit_size[i] == 0,
+                 "Zero flit size for vnet %d.", i);
+        fatal_if(m_vnet_vcs[i] == 0 || m_vnet_vcs[i] > m_vcs_per_vnet,
+                 "Vnet %d should have 1 to %d VCs, got %d.", i,
+                 m_vcs_per_vnet, m_vnet_vcs[i]);
+    }
+
     // record the routers
     for (vector<BasicRouter*>::const_iterator i =  p->routers.begin();
          i != p->routers.end(); ++i) {
@@ -229,6 +261,9 @@ GarnetNetwork::makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
     m_routers[src]->addOutPort(src_outport_dirn, net_link,
                                routing_table_entry,
                                link->m_weight, credit_link);
+
+    m_hop_latency = std::max(m_hop_latency,
+        m_routers[src]->get_pipe_stages() + link->m_latency);
 }
 
 // Total routers in the network
@@ -389,6 +424,25 @@ GarnetNetwork::regStats()
     m_avg_hops.name(name() + ".average_hops");
     m_avg_hops = m_total_hops / sum(m_flits_received);
 
+    // Multicast
+    m_multicast_packets_injected
+        .name(name() + ".multicast_packets_injected")
+        .flags(Stats::nozero);
+    m_multicast_replicated_flits
+        .name(name() + ".multicast_replicated_flits")
+        .flags(Stats::nozero);
+    m_multicast_flit_traversals
+        .name(name() + ".multicast_flit_traversals")
+        .flags(Stats::nozero);
+    m_multicast_unicast_flit_traversals
+        .name(name() + ".multicast_unicast_flit_traversals")
+        .flags(Stats::nozero);
+    m_multicast_traffic_saving
+        .name(name() + ".multicast_traffic_saving")
+        .flags(Stats::nozero);
+    m_multicast_traffic_saving =
+        1 - m_multicast_flit_traversals / m_multicast_unicast_flit_traversals;
+
     // Links
     m_total_ext_in_link_utilization
         .name(name() + ".ext_in_link_utilization");
@@ -404,6 +458,21 @@ GarnetNetwork::regStats()
         .name(name() + ".avg_vc_load")
         .flags(Stats::pdf | Stats::total | Stats::nozero | Stats::oneline)
         ;
+
+    m_vnet_link_utilization
+        .init(m_virtual_networks)
+        .name(name() + ".vnet_link_utilization")
+        .flags(Stats::total | Stats::nozero | Stats::oneline)
+        ;
+    m_average_vnet_link_utilization
+        .init(m_virtual_networks)
+        .name(name() + ".avg_vnet_link_utilization")
+        .flags(Stats::nozero | Stats::oneline)
+        ;
+    for (int i = 0; i < m_virtual_networks; i++) {
+        m_vnet_link_utilization.subname(i, csprintf("vnet-%i", i));
+        m_average_vnet_link_utilization.subname(i, csprintf("vnet-%i", i));
+    }
 }
 
 void
@@ -429,6 +498,17 @@ GarnetNetwork::collateStats()
         vector<unsigned int> vc_load = m_networklinks[i]->getVcLoad();
         for (int j = 0; j < vc_load.size(); j++) {
             m_average_vc_load[j] += ((double)vc_load[j] / time_delta);
+            int vnet = j / m_vcs_per_vnet;
+            m_vnet_link_utilization[vnet] += vc_load[j];
+        }
+    }
+
+    // Average utilization of one link by each vnet.
+    if (!m_networklinks.empty()) {
+        for (int i = 0; i < m_virtual_networks; i++) {
+            m_average_vnet_link_utilization[i] =
+                m_vnet_link_utilization[i].value() /
+                (time_delta * m_networklinks.size());
         }
     }
 
@@ -60,10 +60,25 @@ class GarnetNetwork : public Network
     // for 2D topology
     int getNumRows() const { return m_num_rows; }
     int getNumCols() const { return m_num_cols; }
+    // Latency of one router plus one internal link, the largest if mixed.
+    Cycles getHopLatency() const { return m_hop_latency; }
 
     // for network
     uint32_t getNiFlitSize() const { return m_ni_flit_size; }
     uint32_t getVCsPerVnet() const { return m_vcs_per_vnet; }
+    /**
+     * Each vnet can have its own flit size and use fewer VCs than
+     * vcs_per_vnet, e.g. wide flits for stream responses and narrow flits
+     * for control. All vnets still share the same links and their
+     * bandwidth. VCs are still indexed with the stride vcs_per_vnet, and
+     * only the first getVnetVCs(vnet) are used.
+     */
+    uint32_t getVnetFlitSize(int vnet) const
+    {
+        return m_vnet_flit_size[vnet];
+    }
+    uint32_t getVnetVCs(int vnet) const { return m_vnet_vcs[vnet]; }
+    int getBulkDataVnet() const { return m_bulk_data_vnet; }
     uint32_t getBuffersPerDataVC() { return m_buffers_per_data_vc; }
     uint32_t getBuffersPerCtrlVC() { return m_buffers_per_ctrl_vc; }
     int getRoutingAlgorithm() const { return m_routing_algorithm; }
@@ -72,6 +87,10 @@ class GarnetNetwork : public Network
     FaultModel* fault_model;
 
     bool isMulticastEnabled() const { return m_enable_multicast; }
+    bool isMulticastInRouter() const
+    {
+        return m_enable_multicast && m_multicast_in_router;
+    }
 
     // Internal configuration
     bool isVNetOrdered(int vnet) const { return m_ordered[vnet]; }
@@ -109,7 +128,7 @@ class GarnetNetwork : public Network
     void print(std::ostream& out) const;
 
     // increment counters
-    static constexpr int MAX_MSG_TYPES_PER_CATEGORY = 20;
+    static constexpr int MAX_MSG_TYPES_PER_CATEGORY = 24;
     static constexpr int MAX_MSG_CATEGORY = 2;
     void increment_injected_packets(int vnet) { m_packets_injected[vnet]++; }
     void increment_injected_packet_type(int type) { m_packet_types_injected[type]++; }
@@ -150,6 +169,27 @@ class GarnetNetwork : public Network
         m_total_hop_types[type] += hops;
     }
 
+    /**
+     * Multicast traffic. A flit of a multicast packet counts one traversal
+     * per router it goes through. When it is ejected, we also count the
+     * traversals the same flit would take as a separate unicast packet,
+     * which is the same path length with deterministic routing.
+     */
+    void increment_multicast_packets() { m_multicast_packets_injected++; }
+    void increment_multicast_replicated_flits()
+    {
+        m_multicast_replicated_flits++;
+    }
+    void increment_multicast_flit_traversals()
+    {
+        m_multicast_flit_traversals++;
+    }
+    void
+    increment_multicast_unicast_flit_traversals(int traversals)
+    {
+        m_multicast_unicast_flit_traversals += traversals;
+    }
+
   protected:
     // Configuration
     int m_num_rows;
@@ -160,7 +200,12 @@ class GarnetNetwork : public Network
     uint32_t m_buffers_per_data_vc;
     int m_routing_algorithm;
     bool m_enable_fault_model;
+    std::vector<uint32_t> m_vnet_flit_size;
+    std::vector<uint32_t> m_vnet_vcs;
+    int m_bulk_data_vnet;
     bool m_enable_multicast;
+    bool m_multicast_in_router;
+    Cycles m_hop_latency;
 
     // Statistical variables
     Stats::Vector m_packets_received;
@@ -192,11 +237,19 @@ class GarnetNetwork : public Network
     Stats::Scalar m_total_int_link_utilization;
     Stats::Scalar m_average_link_utilization;
     Stats::Vector m_average_vc_load;
+    Stats::Vector m_vnet_link_utilization;
+    Stats::Vector m_average_vnet_link_utilization;
 
     Stats::Scalar  m_total_hops;
     Stats::Vector  m_total_hop_types;
     Stats::Formula m_avg_hops;
 
+    Stats::Scalar  m_multicast_packets_injected;
+    Stats::Scalar  m_multicast_replicated_flits;
+    Stats::Scalar  m_multicast_flit_traversals;
+    Stats::Scalar  m_multicast_unicast_flit_traversals;
+    Stats::Formula m_multicast_traffic_saving;
+
   private:
     GarnetNetwork(const GarnetNetwork& obj);
     GarnetNetwork& operator=(const GarnetNetwork& obj);
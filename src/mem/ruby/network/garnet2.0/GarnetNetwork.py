@@ -48,7 +48,23 @@ class GarnetNetwork(RubyNetwork):
     fault_model = Param.FaultModel(NULL, "network fault model");
     garnet_deadlock_threshold = Param.UInt32(50000,
                               "network-level deadlock threshold")
+    vnet_flit_size = VectorParam.UInt32([],
+        "flit size in bytes per virtual network, ni_flit_size if empty")
+    vnet_vcs = VectorParam.UInt32([],
+        "virtual channels per virtual network, at most vcs_per_vnet, "
+        "vcs_per_vnet if empty")
+    bulk_data_vnet = Param.Int(-1,
+        "virtual network with its own flit size on the shared links, "
+        "-1 to disable")
+    bulk_data_flit_size = Param.UInt32(64,
+        "flit size in bytes of the bulk data virtual network")
+    bulk_data_vcs = Param.UInt32(0,
+        "virtual channels of the bulk data virtual network, "
+        "vcs_per_vnet if 0")
     enable_multicast = Param.Bool(False, "enable multicast")
+    multicast_in_router = Param.Bool(True,
+        "replicate multicast packets in the router crossbar, one copy per "
+        "outport branch, instead of re-injecting a duplicate at the NI")
 
 class GarnetNetworkInterface(ClockedObject):
     type = 'GarnetNetworkInterface'
@@ -83,6 +83,9 @@ InputUnit::wakeup()
     if (t_flit) {
         int vc = t_flit->get_vc();
         t_flit->increment_hops(); // for stats
+        if (t_flit->isMulticast()) {
+            m_router->get_net_ptr()->increment_multicast_flit_traversals();
+        }
 
         if ((t_flit->get_type() == HEAD_) ||
             (t_flit->get_type() == HEAD_TAIL_)) {
@@ -93,19 +96,30 @@ InputUnit::wakeup()
             assert(virtualChannels[vc].get_state() == ACTIVE_);
         }
 
-        this->allocateMulticastBuffer(t_flit);
-        this->duplicateMulitcastFlit(t_flit);
+        bool multicastInRouter =
+            m_router->get_net_ptr()->isMulticastInRouter();
+        if (!multicastInRouter) {
+            this->allocateMulticastBuffer(t_flit);
+            this->duplicateMulitcastFlit(t_flit);
+        }
 
         auto flitType = t_flit->get_type();
         if ((flitType == HEAD_) || (flitType == HEAD_TAIL_)) {
-            // Route computation for this vc
-            int outport = m_router->route_compute(t_flit->get_route(),
-                m_id, m_direction);
-
-            // Update output port in VC
-            // All flits in this packet will use this output port
-            // The output port field in the flit is updated after it wins SA
-            grant_outport(vc, outport);
+            if (multicastInRouter &&
+                t_flit->get_route().net_dest.count() > 1) {
+                // Route computation for each multicast branch
+                this->computeMulticastBranches(t_flit);
+            } else {
+                // Route computation for this vc
+                int outport = m_router->route_compute(t_flit->get_route(),
+                    m_id, m_direction);
+
+                // Update output port in VC
+                // All flits in this packet will use this output port
+                // The output port field in the flit is updated after it
+                // wins SA
+                grant_outport(vc, outport);
+            }
 
         } else {
             assert(virtualChannels[vc].get_state() == ACTIVE_);
@@ -305,6 +319,51 @@ flit *InputUnit::selectFlit() {
     return nullptr;
 }
 
+void InputUnit::computeMulticastBranches(flit *f) {
+    int vc = f->get_vc();
+    const auto &route = f->get_route();
+    auto branches = m_router->route_compute_multicast(route, m_id,
+        m_direction);
+    if (branches.size() == 1) {
+        // All destinations share the outport, no need to replicate here.
+        grant_outport(vc, branches.front().first);
+        return;
+    }
+
+    /**
+     * Each branch carries its own route and message with only the
+     * destinations reached through that outport. The last branch reuses
+     * the original message, as it takes the original flits.
+     */
+    std::vector<VirtualChannel::MulticastBranchState> vcBranches;
+    for (int i = 0; i < branches.size(); ++i) {
+        const auto &branchDest = branches[i].second;
+        VirtualChannel::MulticastBranchState branch;
+        branch.outport = branches[i].first;
+        branch.outvc = -1;
+        branch.route = route;
+        branch.route.net_dest = branchDest;
+        branch.route.dest_ni = branchDest.getAllDest().front();
+        branch.route.dest_router = m_router->get_net_ptr()->get_router_id(
+            branch.route.dest_ni);
+        if (i + 1 < branches.size()) {
+            branch.msg = f->get_msg_ptr()->clone();
+        } else {
+            branch.msg = f->get_msg_ptr();
+        }
+        branch.msg->getDestination() = branchDest;
+        DPRINTF(RubyMulticast, "InputUnit[%d][%s][%d] Branch [%s] %s.\n",
+            m_router->get_id(),
+            m_router->getPortDirectionName(this->get_direction()),
+            vc,
+            m_router->getPortDirectionName(
+                m_router->getOutportDirection(branch.outport)),
+            branchDest);
+        vcBranches.push_back(std::move(branch));
+    }
+    virtualChannels[vc].set_multicast_branches(std::move(vcBranches));
+}
+
 void InputUnit::allocateMulticastBuffer(flit *f) {
     auto flitType = f->get_type();
     if (flitType != HEAD_ && flitType != HEAD_TAIL_) {
@@ -439,7 +498,8 @@ void InputUnit::duplicateMulitcastFlit(flit *f) {
 }
 
 int InputUnit::calculateVCForMulticastDuplicateFlit(int vnet) {
-    for (int i = 0; i < m_vc_per_vnet; i++) {
+    int vnet_vcs = m_router->get_net_ptr()->getVnetVCs(vnet);
+    for (int i = 0; i < vnet_vcs; i++) {
         auto vc = vnet * m_vc_per_vnet + i;
         if (virtualChannels[vc].get_state() == IDLE_) {
             m_vnet_busy_count[vnet] = 0;
@@ -111,6 +111,24 @@ class InputUnit : public Consumer
         return virtualChannels[vc].getTopFlit();
     }
 
+    inline bool
+    is_multicast(int invc)
+    {
+        return virtualChannels[invc].is_multicast();
+    }
+
+    inline bool
+    is_last_branch(int invc)
+    {
+        return virtualChannels[invc].is_last_branch();
+    }
+
+    inline flit*
+    getTopFlitForBranch(int invc)
+    {
+        return virtualChannels[invc].getTopFlitForBranch();
+    }
+
     inline bool
     need_stage(int vc, flit_stage stage, Cycles time)
     {
@@ -245,6 +263,7 @@ class InputUnit : public Consumer
         flit* inflyFlit,
         const std::vector<MachineID> &destMachineIDs);
     flit *selectFlit();
+    void computeMulticastBranches(flit *f);
     void allocateMulticastBuffer(flit *f);
     void duplicateMulitcastFlit(flit *f);
     int calculateVCForMulticastDuplicateFlit(int vnet);
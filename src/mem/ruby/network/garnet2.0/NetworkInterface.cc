@@ -147,6 +147,12 @@ NetworkInterface::incrementStats(flit *t_flit)
     // Hops
     auto msgType = this->getMessageStatsType(t_flit->get_msg_ptr());
     m_net_ptr->increment_total_hops(t_flit->get_route().hops_traversed, msgType);
+    if (t_flit->isMulticast()) {
+        // As a unicast packet, this flit would traverse all the routers
+        // on its path by itself.
+        m_net_ptr->increment_multicast_unicast_flit_traversals(
+            t_flit->get_route().hops_traversed + 1);
+    }
 }
 
 /*
@@ -332,9 +338,10 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
     }
 
     // Number of flits is dependent on the link bandwidth available.
-    // This is expressed in terms of bytes/cycle or the flit size
+    // This is expressed in terms of bytes/cycle or the flit size,
+    // which can be configured per vnet.
     int num_flits = (int) ceil((double) m_net_ptr->MessageSizeType_to_int(
-        net_msg_ptr->getMessageSize())/m_net_ptr->getNiFlitSize());
+        net_msg_ptr->getMessageSize())/m_net_ptr->getVnetFlitSize(vnet));
 
     // loop to convert all multicast messages into unicast messages
     for (int ctr = 0; ctr < dest_nodes.size(); ctr++) {
@@ -379,11 +386,19 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         auto msgType = this->getMessageStatsType(msg_ptr);
         m_net_ptr->increment_injected_packets(vnet);
         m_net_ptr->increment_injected_packet_type(msgType);
+        // Only track multicast traffic replicated in the routers, as the
+        // duplicates re-injected at the NI start a new route.
+        bool isMulticast = m_net_ptr->isMulticastInRouter() &&
+            route.net_dest.count() > 1;
+        if (isMulticast) {
+            m_net_ptr->increment_multicast_packets();
+        }
         for (int i = 0; i < num_flits; i++) {
             m_net_ptr->increment_injected_flits(vnet);
             m_net_ptr->increment_injected_flit_type(msgType);
             flit *fl = new flit(i, vc, vnet, route, num_flits, new_msg_ptr,
                 curCycle());
+            fl->setMulticast(isMulticast);
 
             fl->set_src_delay(curCycle() - ticksToCycles(msg_ptr->getTime()));
             niOutVcs[vc].insert(fl);
@@ -406,10 +421,12 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
 int
 NetworkInterface::calculateVC(int vnet)
 {
-    for (int i = 0; i < m_vc_per_vnet; i++) {
+    // Only the first few VCs may be used by this vnet.
+    const int vnet_vcs = m_net_ptr->getVnetVCs(vnet);
+    for (int i = 0; i < vnet_vcs; i++) {
         int delta = m_vc_allocator[vnet];
         m_vc_allocator[vnet]++;
-        if (m_vc_allocator[vnet] == m_vc_per_vnet)
+        if (m_vc_allocator[vnet] >= vnet_vcs)
             m_vc_allocator[vnet] = 0;
 
         if (outVcState[(vnet*m_vc_per_vnet) + delta].isInState(
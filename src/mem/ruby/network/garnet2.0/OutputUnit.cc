@@ -84,7 +84,8 @@ bool
 OutputUnit::has_free_vc(int vnet)
 {
     int vc_base = vnet*m_vc_per_vnet;
-    for (int vc = vc_base; vc < vc_base + m_vc_per_vnet; vc++) {
+    int vc_end = vc_base + m_router->get_net_ptr()->getVnetVCs(vnet);
+    for (int vc = vc_base; vc < vc_end; vc++) {
         if (is_vc_idle(vc, m_router->curCycle()))
             return true;
     }
@@ -97,7 +98,8 @@ int
 OutputUnit::select_free_vc(int vnet)
 {
     int vc_base = vnet*m_vc_per_vnet;
-    for (int vc = vc_base; vc < vc_base + m_vc_per_vnet; vc++) {
+    int vc_end = vc_base + m_router->get_net_ptr()->getVnetVCs(vnet);
+    for (int vc = vc_base; vc < vc_end; vc++) {
         if (is_vc_idle(vc, m_router->curCycle())) {
             outVcState[vc].setState(ACTIVE_, m_router->curCycle());
             return vc;
@@ -31,6 +31,7 @@
 
 #include "mem/ruby/network/garnet2.0/Router.hh"
 
+#include "base/host_profile.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet2.0/CreditLink.hh"
 #include "mem/ruby/network/garnet2.0/GarnetNetwork.hh"
@@ -59,9 +60,12 @@ Router::init()
     crossbarSwitch.init();
 }
 
+HOST_PROFILE_COUNTER(hostProfileRouterWakeup, "garnet.router.wakeup");
+
 void
 Router::wakeup()
 {
+    HOST_PROFILE_SCOPE(hostProfileRouterWakeup);
     DPRINTF(RubyNetwork, "Router %d woke up\n", m_id);
 
     // check for incoming flits
@@ -142,6 +146,13 @@ Router::route_compute(RouteInfo route, int inport, PortDirection inport_dirn)
     return routingUnit.outportCompute(route, inport, inport_dirn);
 }
 
+std::vector<RoutingUnit::MulticastBranch>
+Router::route_compute_multicast(const RouteInfo &route, int inport,
+                                PortDirection inport_dirn)
+{
+    return routingUnit.outportComputeMulticast(route, inport, inport_dirn);
+}
+
 void
 Router::grant_switch(int inport, flit *t_flit)
 {
@@ -30,6 +30,8 @@
 
 #include "mem/ruby/network/garnet2.0/RoutingUnit.hh"
 
+#include <algorithm>
+
 #include "base/cast.hh"
 #include "base/logging.hh"
 #include "mem/ruby/network/garnet2.0/InputUnit.hh"
@@ -169,6 +171,40 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
     return outport;
 }
 
+std::vector<RoutingUnit::MulticastBranch>
+RoutingUnit::outportComputeMulticast(const RouteInfo &route, int inport,
+                                     PortDirection inport_dirn)
+{
+    std::map<int, NetDest> grouped;
+    for (auto destNI : route.net_dest.getAllDest()) {
+        auto destMachineID = MachineID::getMachineIDFromRawNodeID(destNI);
+        RouteInfo destRoute = route;
+        destRoute.net_dest.clear();
+        destRoute.net_dest.add(destMachineID);
+        destRoute.dest_ni = destNI;
+        destRoute.dest_router = m_router->get_net_ptr()->get_router_id(destNI);
+        int outport = outportCompute(destRoute, inport, inport_dirn);
+        grouped[outport].add(destMachineID);
+    }
+
+    auto dimension = [this](int outport) -> int {
+        const auto &dirn = m_outports_idx2dirn[outport];
+        if (dirn == "East" || dirn == "West") {
+            return 0;
+        } else if (dirn == "North" || dirn == "South") {
+            return 1;
+        }
+        return 2;
+    };
+
+    std::vector<MulticastBranch> branches(grouped.begin(), grouped.end());
+    std::stable_sort(branches.begin(), branches.end(),
+        [&dimension](const MulticastBranch &a, const MulticastBranch &b) {
+            return dimension(a.first) < dimension(b.first);
+        });
+    return branches;
+}
+
 // XY routing implemented using port directions
 // Only for reference purpose in a Mesh
 // By default Garnet uses the routing table
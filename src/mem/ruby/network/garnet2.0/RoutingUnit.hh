@@ -48,6 +48,19 @@ class RoutingUnit
                       int inport,
                       PortDirection inport_dirn);
 
+    /**
+     * Split a multicast route into branches, one per outport, each with
+     * the destinations reached through that outport. Every destination
+     * is routed as if it were unicast, so with XY routing the branches
+     * of all routers form the XY tree rooted at the source. Branches are
+     * ordered X dimension first, then Y, then local ejection, so that a
+     * flit waiting for a later branch only holds channels from turns
+     * allowed by XY routing.
+     */
+    using MulticastBranch = std::pair<int, NetDest>;
+    std::vector<MulticastBranch> outportComputeMulticast(
+        const RouteInfo &route, int inport, PortDirection inport_dirn);
+
     // Topology-agnostic Routing Table based routing (default)
     void addRoute(const NetDest& routing_table_entry);
     void addWeight(int link_weight);
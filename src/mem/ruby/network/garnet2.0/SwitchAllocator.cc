@@ -195,7 +195,21 @@ SwitchAllocator::arbitrate_outports()
                 }
 
                 // remove flit from Input VC
-                flit *t_flit = input_unit->getTopFlit(invc);
+                // For multicast, the flit stays in the Input VC until
+                // it is sent to the last branch, and the other branches
+                // get a copy.
+                flit *t_flit = nullptr;
+                bool last_branch = true;
+                if (input_unit->is_multicast(invc)) {
+                    last_branch = input_unit->is_last_branch(invc);
+                    t_flit = input_unit->getTopFlitForBranch(invc);
+                    if (!last_branch) {
+                        m_router->get_net_ptr()->
+                            increment_multicast_replicated_flits();
+                    }
+                } else {
+                    t_flit = input_unit->getTopFlit(invc);
+                }
 
                 DPRINTF(RubyNetwork, "SA[%d] "
                                      "Grant [%s][%d] -> [%s][%d] to flit %s at "
@@ -230,7 +244,10 @@ SwitchAllocator::arbitrate_outports()
                 m_router->grant_switch(inport, t_flit);
                 m_output_arbiter_activity++;
 
-                if ((t_flit->get_type() == TAIL_) ||
+                if (!last_branch) {
+                    // The flit is still buffered for the remaining
+                    // multicast branches, so no credit is sent back yet.
+                } else if ((t_flit->get_type() == TAIL_) ||
                     t_flit->get_type() == HEAD_TAIL_) {
 
                     // This Input VC should now be empty
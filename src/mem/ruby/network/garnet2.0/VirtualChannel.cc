@@ -33,7 +33,7 @@
 
 VirtualChannel::VirtualChannel()
   : inputBuffer(), m_vc_state(IDLE_, Cycles(0)), m_output_port(-1),
-    m_enqueue_time(INFINITE_), m_output_vc(-1)
+    m_enqueue_time(INFINITE_), m_output_vc(-1), m_branch_idx(0)
 {
 }
 
@@ -45,6 +45,8 @@ VirtualChannel::set_idle(Cycles curTime)
     m_enqueue_time = Cycles(INFINITE_);
     m_output_port = -1;
     m_output_vc = -1;
+    m_branches.clear();
+    m_branch_idx = 0;
 }
 
 void
@@ -66,6 +68,44 @@ VirtualChannel::need_stage(flit_stage stage, Cycles time)
     return false;
 }
 
+void
+VirtualChannel::set_multicast_branches(
+    std::vector<MulticastBranchState> branches)
+{
+    assert(!branches.empty());
+    m_branches = std::move(branches);
+    m_branch_idx = 0;
+    m_output_port = m_branches.front().outport;
+    m_output_vc = m_branches.front().outvc;
+}
+
+flit *
+VirtualChannel::getTopFlitForBranch()
+{
+    assert(is_multicast());
+    auto &branch = m_branches[m_branch_idx];
+    // Remember the outvc allocated to this branch for the following flits.
+    branch.outvc = m_output_vc;
+
+    flit *t_flit = nullptr;
+    if (is_last_branch()) {
+        t_flit = inputBuffer.getTopFlit();
+        m_branch_idx = 0;
+    } else {
+        t_flit = new flit(*inputBuffer.peekTopFlit());
+        m_branch_idx++;
+    }
+    RouteInfo route = branch.route;
+    route.hops_traversed = t_flit->get_route().hops_traversed;
+    t_flit->set_route(route);
+    t_flit->get_msg_ptr() = branch.msg;
+
+    const auto &next = m_branches[m_branch_idx];
+    m_output_port = next.outport;
+    m_output_vc = next.outvc;
+    return t_flit;
+}
+
 uint32_t
 VirtualChannel::functionalWrite(Packet *pkt)
 {
@@ -33,6 +33,7 @@
 #define __MEM_RUBY_NETWORK_GARNET2_0_VIRTUALCHANNEL_HH__
 
 #include <utility>
+#include <vector>
 
 #include "mem/ruby/network/garnet2.0/CommonTypes.hh"
 #include "mem/ruby/network/garnet2.0/flitBuffer.hh"
@@ -90,6 +91,28 @@ class VirtualChannel
         return inputBuffer.getTopFlit();
     }
 
+    /**
+     * Multicast replication in the router. The packet is sent to all its
+     * branches flit by flit: for each flit, all but the last branch get a
+     * copy, and the last branch takes the flit out of the buffer. The
+     * outport and outvc of this VC always refer to the current branch.
+     */
+    struct MulticastBranchState
+    {
+        int outport;
+        int outvc;
+        RouteInfo route;
+        MsgPtr msg;
+    };
+    void set_multicast_branches(std::vector<MulticastBranchState> branches);
+    inline bool is_multicast() const { return !m_branches.empty(); }
+    inline bool
+    is_last_branch() const
+    {
+        return m_branch_idx + 1 >= (int)m_branches.size();
+    }
+    flit *getTopFlitForBranch();
+
     uint32_t functionalWrite(Packet *pkt);
 
   private:
@@ -98,6 +121,8 @@ class VirtualChannel
     int m_output_port;
     Cycles m_enqueue_time;
     int m_output_vc;
+    std::vector<MulticastBranchState> m_branches;
+    int m_branch_idx;
 };
 
 #endif // __MEM_RUBY_NETWORK_GARNET2_0_VIRTUALCHANNEL_HH__
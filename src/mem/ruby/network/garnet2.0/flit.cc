@@ -30,6 +30,42 @@
 
 #include "mem/ruby/network/garnet2.0/flit.hh"
 
+std::vector<FlitPool::Bucket> FlitPool::buckets;
+
+FlitPool::Bucket &
+FlitPool::getBucket(size_t size)
+{
+    // There are only flit and Credit, linear search is enough.
+    for (auto &bucket : buckets) {
+        if (bucket.size == size) {
+            return bucket;
+        }
+    }
+    buckets.emplace_back();
+    buckets.back().size = size;
+    return buckets.back();
+}
+
+void *
+FlitPool::allocate(size_t size)
+{
+    auto &freeList = getBucket(size).freeList;
+    if (freeList.empty()) {
+        return ::operator new(size);
+    }
+    void *p = freeList.back();
+    freeList.pop_back();
+    return p;
+}
+
+void
+FlitPool::release(void *p, size_t size)
+{
+    if (p) {
+        getBucket(size).freeList.push_back(p);
+    }
+}
+
 // Constructor for the flit
 flit::flit(int id, int  vc, int vnet, RouteInfo route, int size,
     MsgPtr msg_ptr, Cycles curTime)
@@ -33,11 +33,35 @@
 
 #include <cassert>
 #include <iostream>
+#include <vector>
 
 #include "base/types.hh"
 #include "mem/ruby/network/garnet2.0/CommonTypes.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 
+/**
+ * Free-list pool for flits and credits. Every packet allocates its flits
+ * at the source NI and frees them at the destination, so we recycle the
+ * memory instead of going through malloc for every flit. Blocks are
+ * bucketed by size as Credit is a larger subclass of flit.
+ * Ruby is single threaded, so one pool is shared by all the networks.
+ */
+class FlitPool
+{
+  public:
+    static void *allocate(size_t size);
+    static void release(void *p, size_t size);
+
+  private:
+    struct Bucket
+    {
+        size_t size;
+        std::vector<void *> freeList;
+    };
+    static std::vector<Bucket> buckets;
+    static Bucket &getBucket(size_t size);
+};
+
 class flit
 {
   public:
@@ -45,6 +69,13 @@ class flit
     flit(int id, int vc, int vnet, RouteInfo route, int size,
          MsgPtr msg_ptr, Cycles curTime);
 
+    static void *operator new(size_t size) { return FlitPool::allocate(size); }
+    static void
+    operator delete(void *p, size_t size)
+    {
+        FlitPool::release(p, size);
+    }
+
     int get_outport() {return m_outport; }
     int get_size() { return m_size; }
     Cycles get_enqueue_time() { return m_enqueue_time; }
@@ -104,6 +135,9 @@ class flit
         this->multicastDuplicate = multicastDuplicate;
     }
 
+    bool isMulticast() const { return this->multicast; }
+    void setMulticast(bool multicast) { this->multicast = multicast; }
+
   protected:
     int m_id;
     int m_vnet;
@@ -123,6 +157,11 @@ class flit
      * duplicated flits.
      */
     bool multicastDuplicate = false;
+    /**
+     * Set by NetworkInterface if the packet has multiple destinations.
+     * Kept by all the copies replicated in the routers for stats.
+     */
+    bool multicast = false;
 };
 
 inline std::ostream&
@@ -43,13 +43,13 @@ flitBuffer::flitBuffer(int maximum_size)
 bool
 flitBuffer::isEmpty()
 {
-    return (m_buffer.size() == 0);
+    return (getSize() == 0);
 }
 
 bool
 flitBuffer::isReady(Cycles curTime)
 {
-    if (m_buffer.size() != 0 ) {
+    if (getSize() != 0 ) {
         flit *t_flit = peekTopFlit();
         if (t_flit->get_time() <= curTime)
             return true;
@@ -60,13 +60,13 @@ flitBuffer::isReady(Cycles curTime)
 void
 flitBuffer::print(std::ostream& out) const
 {
-    out << "[flitBuffer: " << m_buffer.size() << "] " << std::endl;
+    out << "[flitBuffer: " << getSize() << "] " << std::endl;
 }
 
 bool
 flitBuffer::isFull()
 {
-    return (m_buffer.size() >= max_size);
+    return (getSize() >= max_size);
 }
 
 void
@@ -80,6 +80,12 @@ flitBuffer::functionalWrite(Packet *pkt)
 {
     uint32_t num_functional_writes = 0;
 
+    for (int i = 0; i < m_ring_size; ++i) {
+        flit *f = m_ring[(m_ring_head + i) & (m_ring.size() - 1)];
+        if (f->functionalWrite(pkt)) {
+            num_functional_writes++;
+        }
+    }
     for (unsigned int i = 0; i < m_buffer.size(); ++i) {
         if (m_buffer[i]->functionalWrite(pkt)) {
             num_functional_writes++;
@@ -88,3 +94,32 @@ flitBuffer::functionalWrite(Packet *pkt)
 
     return num_functional_writes;
 }
+
+void
+flitBuffer::pushRing(flit *flt)
+{
+    if (m_ring_size == (int)m_ring.size()) {
+        // Grow to the next power of 2 and linearize the ring.
+        std::vector<flit *> ring(std::max(m_ring.size() * 2, (size_t)4));
+        for (int i = 0; i < m_ring_size; ++i) {
+            ring[i] = m_ring[(m_ring_head + i) & (m_ring.size() - 1)];
+        }
+        m_ring.swap(ring);
+        m_ring_head = 0;
+    }
+    m_ring[(m_ring_head + m_ring_size) & (m_ring.size() - 1)] = flt;
+    m_ring_size++;
+}
+
+void
+flitBuffer::switchToHeap()
+{
+    // The ring is sorted, which is already a valid heap.
+    assert(m_buffer.empty());
+    for (int i = 0; i < m_ring_size; ++i) {
+        m_buffer.push_back(m_ring[(m_ring_head + i) & (m_ring.size() - 1)]);
+    }
+    m_ring_head = 0;
+    m_ring_size = 0;
+    m_fifo_mode = false;
+}
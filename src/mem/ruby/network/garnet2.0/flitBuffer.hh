@@ -49,26 +49,46 @@ class flitBuffer
     void print(std::ostream& out) const;
     bool isFull();
     void setMaxSize(int maximum);
-    int getSize() const { return m_buffer.size(); }
+    int getSize() const
+    {
+        return m_fifo_mode ? m_ring_size : m_buffer.size();
+    }
 
     flit *
     getTopFlit()
     {
+        if (m_fifo_mode) {
+            flit *f = m_ring[m_ring_head];
+            m_ring_head = (m_ring_head + 1) & (m_ring.size() - 1);
+            m_ring_size--;
+            return f;
+        }
         flit *f = m_buffer.front();
         std::pop_heap(m_buffer.begin(), m_buffer.end(), flit::greater);
         m_buffer.pop_back();
+        if (m_buffer.empty()) {
+            // Drained, go back to the fast path.
+            m_fifo_mode = true;
+        }
         return f;
     }
 
     flit *
     peekTopFlit()
     {
-        return m_buffer.front();
+        return m_fifo_mode ? m_ring[m_ring_head] : m_buffer.front();
     }
 
     void
     insert(flit *flt)
     {
+        if (m_fifo_mode) {
+            if (m_ring_size == 0 || !flit::greater(ringBack(), flt)) {
+                pushRing(flt);
+                return;
+            }
+            switchToHeap();
+        }
         m_buffer.push_back(flt);
         std::push_heap(m_buffer.begin(), m_buffer.end(), flit::greater);
     }
@@ -76,8 +96,28 @@ class flitBuffer
     uint32_t functionalWrite(Packet *pkt);
 
   private:
+    /**
+     * Most buffers receive flits in time order, so we keep them in a
+     * ring buffer (FIFO mode) and only fall back to the binary heap when
+     * an out-of-order flit is inserted. We return to FIFO mode once the
+     * heap is drained.
+     */
+    bool m_fifo_mode = true;
+    std::vector<flit *> m_ring;
+    int m_ring_head = 0;
+    int m_ring_size = 0;
+
     std::vector<flit *> m_buffer;
     int max_size;
+
+    flit *
+    ringBack() const
+    {
+        return m_ring[(m_ring_head + m_ring_size - 1) & (m_ring.size() - 1)];
+    }
+
+    void pushRing(flit *flt);
+    void switchToHeap();
 };
 
 inline std::ostream&
@@ -1,6 +1,9 @@
 #include "AbstractStreamAwareController.hh"
 
+#include "arch/isa_traits.hh"
+#include "mem/cache/compressors/base.hh"
 #include "mem/ruby/network/garnet2.0/GarnetNetwork.hh"
+#include "mem/ruby/system/RubySystem.hh"
 #include "sim/stream_nuca/stream_nuca_map.hh"
 
 #include "RubySlicc_ComponentMapping.hh"
@@ -75,6 +78,27 @@ void AbstractStreamAwareController::regStats() {
   m_statLLCMulticastStreamReq.name(name() + ".llcMulticastStreamRequests")
       .desc("number of llc multicast stream requests seen")
       .flags(Stats::nozero);
+  m_statStreamRegionFetch.name(name() + ".streamRegionFetch")
+      .desc("number of stream region fetch sent to memory")
+      .flags(Stats::nozero);
+  m_statStreamRegionFetchLines.name(name() + ".streamRegionFetchLines")
+      .desc("number of follower lines in stream region fetch")
+      .flags(Stats::nozero);
+  m_statStreamRegionFetchNack.name(name() + ".streamRegionFetchNack")
+      .desc("number of follower lines skipped by memory")
+      .flags(Stats::nozero);
+  m_statStreamRegionFetchDrop.name(name() + ".streamRegionFetchDrop")
+      .desc("number of follower lines dropped due to no space")
+      .flags(Stats::nozero);
+  m_statStreamCompressedData.name(name() + ".streamCompressedData")
+      .desc("number of stream data messages compressed")
+      .flags(Stats::nozero);
+  m_statStreamUncompressedBytes.name(name() + ".streamUncompressedBytes")
+      .desc("stream data payload bytes before compression")
+      .flags(Stats::nozero);
+  m_statStreamCompressedBytes.name(name() + ".streamCompressedBytes")
+      .desc("stream data payload bytes after compression")
+      .flags(Stats::nozero);
   m_statLLCScheduledComputation.name(name() + ".llcScheduledStreamComputation")
       .desc("number of llc stream computation scheduled")
       .flags(Stats::nozero);
@@ -313,6 +337,83 @@ void AbstractStreamAwareController::recordLLCReqQueueStats(
   }
 }
 
+int AbstractStreamAwareController::allocateStreamRegionFetch(
+    Addr lineAddr, int maxLines, CacheMemory &cache) {
+  maxLines = std::min(maxLines, this->getStreamRegionFetchLines());
+  if (maxLines <= 1) {
+    return 0;
+  }
+  auto blockSize = RubySystem::getBlockSizeBytes();
+  auto pageSize = TheISA::PageBytes;
+  auto myMachineId = this->getMachineID();
+  auto memMachineId =
+      this->mapAddressToLLCOrMem(lineAddr, MachineType_Directory);
+  int followers = 0;
+  for (int i = 1; i < maxLines; ++i) {
+    Addr followerAddr = lineAddr + i * blockSize;
+    if ((followerAddr / pageSize) != (lineAddr / pageSize)) {
+      break;
+    }
+    if (this->mapAddressToLLCOrMem(followerAddr, myMachineId.getType()) !=
+        myMachineId) {
+      break;
+    }
+    if (this->mapAddressToLLCOrMem(followerAddr, MachineType_Directory) !=
+        memMachineId) {
+      break;
+    }
+    if (cache.isTagPresent(followerAddr) ||
+        this->isStreamRegionFetchPending(followerAddr)) {
+      break;
+    }
+    followers++;
+  }
+  for (int i = 1; i <= followers; ++i) {
+    this->streamRegionFetchPendingLines.insert(lineAddr + i * blockSize);
+  }
+  if (followers > 0) {
+    m_statStreamRegionFetch++;
+    m_statStreamRegionFetchLines += followers;
+  }
+  return followers;
+}
+
+int AbstractStreamAwareController::compressStreamData(const uint8_t *data,
+                                                      int lineOffset,
+                                                      int dataSize,
+                                                      int payloadSize) {
+  auto compressor = this->myParams->stream_compressor;
+  if (!compressor) {
+    return payloadSize;
+  }
+  auto blockSize = RubySystem::getBlockSizeBytes();
+  assert(lineOffset + dataSize <= blockSize);
+  std::vector<uint64_t> line((blockSize + sizeof(uint64_t) - 1) /
+                                 sizeof(uint64_t),
+                             0);
+  memcpy(reinterpret_cast<uint8_t *>(line.data()) + lineOffset, data,
+         dataSize);
+  Cycles compressLat;
+  Cycles decompressLat;
+  std::size_t compressedBits;
+  compressor->compress(line.data(), compressLat, decompressLat,
+                       compressedBits);
+  int compressedSize = std::min(
+      payloadSize, static_cast<int>((compressedBits + 7) / 8));
+  m_statStreamCompressedData++;
+  m_statStreamUncompressedBytes += payloadSize;
+  m_statStreamCompressedBytes += compressedSize;
+  return compressedSize;
+}
+
+void AbstractStreamAwareController::deallocateStreamRegionFetch(
+    Addr lineAddr) {
+  if (!this->streamRegionFetchPendingLines.erase(lineAddr)) {
+    panic("%s: Deallocate non-pending StreamRegionFetch %#x.\n", name(),
+          lineAddr);
+  }
+}
+
 int AbstractStreamAwareController::getNumRows() const {
   auto network = this->m_net_ptr;
   auto garnet = dynamic_cast<GarnetNetwork *>(network);
@@ -329,6 +430,14 @@ int AbstractStreamAwareController::getNumCols() const {
   }
   return garnet->getNumCols();
 }
+Cycles AbstractStreamAwareController::getHopLatency() const {
+  auto network = this->m_net_ptr;
+  auto garnet = dynamic_cast<GarnetNetwork *>(network);
+  if (!garnet) {
+    panic("Only works with Garnet to get HopLatency.");
+  }
+  return garnet->getHopLatency();
+}
 
 bool AbstractStreamAwareController::isMyNeighbor(MachineID machineId) const {
   auto cols = this->getNumCols();
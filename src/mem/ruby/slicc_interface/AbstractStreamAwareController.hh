@@ -8,6 +8,8 @@
 #include "mem/ruby/structures/CacheMemory.hh"
 #include "params/RubyStreamAwareController.hh"
 
+#include <unordered_set>
+
 /**
  * ! Sean: StreamAwareCache.
  * ! An abstract cache controller with stream information.
@@ -30,6 +32,7 @@ public:
    */
   int getNumRows() const;
   int getNumCols() const;
+  Cycles getHopLatency() const;
   bool isMyNeighbor(MachineID machineId) const;
 
   /**
@@ -91,6 +94,45 @@ public:
     return this->myParams->enable_stream_float_mem;
   }
 
+  int getStreamRegionFetchLines() const {
+    return this->myParams->stream_region_fetch_lines;
+  }
+  bool isStreamRegionFetchEnabled() const {
+    return this->getStreamRegionFetchLines() > 1;
+  }
+
+  /**
+   * Stream region fetch: the L2 fetches the missing line with a normal GETS,
+   * and asks the memory controller to also stream back the following lines
+   * of the region. These followers are tracked here so that requests to
+   * them are stalled until the region data (or a NACK) comes back.
+   *
+   * The region stops at the first line that is not mapped to this bank or
+   * the same memory controller, crosses the page, or is already present or
+   * pending in the cache.
+   * @return number of follower lines (excluding lineAddr) registered.
+   */
+  int allocateStreamRegionFetch(Addr lineAddr, int maxLines,
+                                CacheMemory &cache);
+  bool isStreamRegionFetchPending(Addr lineAddr) const {
+    return this->streamRegionFetchPendingLines.count(lineAddr);
+  }
+  void deallocateStreamRegionFetch(Addr lineAddr);
+  void recordStreamRegionFetchNack() { this->m_statStreamRegionFetchNack++; }
+  void recordStreamRegionFetchDrop() { this->m_statStreamRegionFetchDrop++; }
+
+  /**
+   * Stream data compression. The payload is compressed with the selected
+   * compressor only to size the message, the data is sent as is.
+   * The bytes outside the payload are zeroed before compression.
+   * @return compressed payload size in bytes, at most payloadSize.
+   */
+  bool isStreamCompressEnabled() const {
+    return this->myParams->stream_compressor != nullptr;
+  }
+  int compressStreamData(const uint8_t *data, int lineOffset, int dataSize,
+                         int payloadSize);
+
   const char *getMachineTypeString() const {
     auto type = this->getMachineID().type;
     switch (type) {
@@ -158,6 +200,27 @@ public:
     }
   }
 
+  /**
+   * Round up the compressed payload size to the message size.
+   */
+  MessageSizeType getCompressedMessageSizeType(int size) const {
+    if (size <= 1) {
+      return MessageSizeType_Response_Data_1B;
+    } else if (size <= 2) {
+      return MessageSizeType_Response_Data_2B;
+    } else if (size <= 4) {
+      return MessageSizeType_Response_Data_4B;
+    } else if (size <= 8) {
+      return MessageSizeType_Response_Data_8B;
+    } else if (size <= 16) {
+      return MessageSizeType_Response_Data_16B;
+    } else if (size <= 32) {
+      return MessageSizeType_Response_Data_32B;
+    } else {
+      return MessageSizeType_Response_Data;
+    }
+  }
+
   /**
    * Set the hit cache level of the request.
    */
@@ -262,6 +325,11 @@ private:
   MLCStreamEngine *mlcSE = nullptr;
   LLCStreamEngine *llcSE = nullptr;
 
+  /**
+   * Follower lines of stream region fetches that are still infly.
+   */
+  std::unordered_set<Addr> streamRegionFetchPendingLines;
+
   /**
    * Get the global StreamAwareCacheController map.
    */
@@ -280,6 +348,13 @@ protected:
   Stats::Scalar m_statLLCStreamReq;
   Stats::Scalar m_statLLCIndStreamReq;
   Stats::Scalar m_statLLCMulticastStreamReq;
+  Stats::Scalar m_statStreamRegionFetch;
+  Stats::Scalar m_statStreamRegionFetchLines;
+  Stats::Scalar m_statStreamRegionFetchNack;
+  Stats::Scalar m_statStreamRegionFetchDrop;
+  Stats::Scalar m_statStreamCompressedData;
+  Stats::Scalar m_statStreamUncompressedBytes;
+  Stats::Scalar m_statStreamCompressedBytes;
 
 public:
   Stats::Distribution m_statLLCNumDirectStreams;
@@ -39,6 +39,7 @@
 from m5.params import *
 from m5.proxy import *
 from m5.objects.ClockedObject import ClockedObject
+from m5.objects.Compressors import BaseCacheCompressor
 from m5.objects.Sequencer import RubySequencer
 
 class RubyController(ClockedObject):
@@ -139,3 +140,7 @@ class RubyStreamAwareController(RubyController):
 
     enable_stream_float_mem = Param.Bool(False, "Whether to enable stream float to mem ctrl.")
     reuse_buffer_lines_per_core = Param.UInt32(0, "Number of cache lines per core in the reuse buffer.")
+    stream_region_fetch_lines = \
+        Param.UInt32(0, "Max lines per stream region fetch to memory, <= 1 to disable.")
+    stream_compressor = Param.BaseCacheCompressor(NULL,
+        "Compressor to size stream data messages sent from LLC, NULL to disable.")
@@ -76,6 +76,10 @@ CacheMemory::CacheMemory(const Params *p)
     m_use_occupancy = dynamic_cast<WeightedLRUPolicy*>(
                                     m_replacementPolicy_ptr) ? true : false;
     m_query_stream_nuca = p->query_stream_nuca;
+    m_num_stream_ways = p->num_stream_ways;
+    fatal_if(m_num_stream_ways < 0 || m_num_stream_ways >= m_cache_assoc,
+             "Invalid %d stream ways for %d-way cache.",
+             m_num_stream_ways, m_cache_assoc);
 }
 
 void
@@ -272,17 +276,51 @@ CacheMemory::isTagPresent(Addr address) const
     return true;
 }
 
+int
+CacheMemory::wayBegin(bool isStream) const
+{
+    if (isStream && m_num_stream_ways > 0) {
+        return m_cache_assoc - m_num_stream_ways;
+    }
+    return 0;
+}
+
+int
+CacheMemory::wayEnd(bool isStream) const
+{
+    if (isStream) {
+        return m_cache_assoc;
+    }
+    return m_cache_assoc - m_num_stream_ways;
+}
+
 // Returns true if there is:
 //   a) a tag match on this address or there is
 //   b) an unused line in the same cache "way"
 bool
 CacheMemory::cacheAvail(Addr address) const
+{
+    return cacheAvailInWays(address, false /* isStream */);
+}
+
+bool
+CacheMemory::cacheAvailForStream(Addr address) const
+{
+    return cacheAvailInWays(address, true /* isStream */);
+}
+
+bool
+CacheMemory::cacheAvailInWays(Addr address, bool isStream) const
 {
     assert(address == makeLineAddress(address));
 
     int64_t cacheSet = addressToCacheSet(address);
+    if (m_num_stream_ways > 0 && findTagInSet(cacheSet, address) != -1) {
+        // Already in the cache, maybe in the other ways.
+        return true;
+    }
 
-    for (int i = 0; i < m_cache_assoc; i++) {
+    for (int i = wayBegin(isStream); i < wayEnd(isStream); i++) {
         AbstractCacheEntry* entry = m_cache[cacheSet][i];
         if (entry != NULL) {
             if (entry->m_Address == address ||
@@ -299,16 +337,32 @@ CacheMemory::cacheAvail(Addr address) const
 
 AbstractCacheEntry*
 CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
+{
+    return allocateInWays(address, entry, false /* isStream */);
+}
+
+AbstractCacheEntry*
+CacheMemory::allocateForStream(Addr address, AbstractCacheEntry *entry)
+{
+    if (m_num_stream_ways > 0) {
+        m_stream_way_allocated++;
+    }
+    return allocateInWays(address, entry, true /* isStream */);
+}
+
+AbstractCacheEntry*
+CacheMemory::allocateInWays(Addr address, AbstractCacheEntry *entry,
+                            bool isStream)
 {
     assert(address == makeLineAddress(address));
     assert(!isTagPresent(address));
-    assert(cacheAvail(address));
-    DPRINTF(RubyCache, "address: %#x\n", address);
+    assert(cacheAvailInWays(address, isStream));
+    DPRINTF(RubyCache, "address: %#x stream %d\n", address, isStream);
 
     // Find the first open slot
     int64_t cacheSet = addressToCacheSet(address);
     std::vector<AbstractCacheEntry*> &set = m_cache[cacheSet];
-    for (int i = 0; i < m_cache_assoc; i++) {
+    for (int i = wayBegin(isStream); i < wayEnd(isStream); i++) {
         if (!set[i] || set[i]->m_Permission == AccessPermission_NotPresent) {
             if (set[i] && (set[i] != entry)) {
                 warn_once("This protocol contains a cache entry handling bug: "
@@ -354,11 +408,41 @@ CacheMemory::deallocate(Addr address)
 // Returns with the physical address of the conflicting cache line
 Addr
 CacheMemory::cacheProbe(Addr address) const
+{
+    return cacheProbeInWays(address, false /* isStream */);
+}
+
+Addr
+CacheMemory::cacheProbeForStream(Addr address) const
+{
+    return cacheProbeInWays(address, true /* isStream */);
+}
+
+Addr
+CacheMemory::cacheProbeInWays(Addr address, bool isStream) const
 {
     assert(address == makeLineAddress(address));
-    assert(!cacheAvail(address));
+    assert(!cacheAvailInWays(address, isStream));
 
     int64_t cacheSet = addressToCacheSet(address);
+    if (m_num_stream_ways > 0) {
+        // The replacement policy (e.g. TreePLRU) works on the whole set,
+        // so pick the least recently touched line within the ways.
+        int victim = -1;
+        for (int i = wayBegin(isStream); i < wayEnd(isStream); i++) {
+            const AbstractCacheEntry *entry = m_cache[cacheSet][i];
+            if (entry->isLockedRMW()) {
+                continue;
+            }
+            if (victim == -1 || entry->getLastAccess() <
+                    m_cache[cacheSet][victim]->getLastAccess()) {
+                victim = i;
+            }
+        }
+        panic_if(victim == -1, "No victim in ways for %#x.", address);
+        return m_cache[cacheSet][victim]->m_Address;
+    }
+
     std::vector<ReplaceableEntry*> candidates;
     for (int i = 0; i < m_cache_assoc; i++) {
         // ! GemForge
@@ -614,6 +698,9 @@ CacheMemory::regStats()
     m_deallocated
         .name(name() + ".deallocated")
         .desc("Number of cache line deallocated");
+    m_stream_way_allocated
+        .name(name() + ".stream_way_allocated")
+        .desc("Number of stream lines allocated in the reserved ways");
     m_deallocated_no_reuse
         .name(name() + ".deallocated_no_reuse")
         .desc("Number of cache line deallocated before any reuse");
@@ -95,6 +95,15 @@ class CacheMemory : public SimObject
     // Returns with the physical address of the conflicting cache line
     Addr cacheProbe(Addr address) const;
 
+    // ! GemForge
+    // Same as above, but within the ways reserved for streams.
+    // Without reserved ways, streams share all the ways.
+    bool hasStreamWays() const { return m_num_stream_ways > 0; }
+    bool cacheAvailForStream(Addr address) const;
+    AbstractCacheEntry* allocateForStream(Addr address,
+                                          AbstractCacheEntry* new_entry);
+    Addr cacheProbeForStream(Addr address) const;
+
     // looks an address up in the cache
     AbstractCacheEntry* lookup(Addr address);
     const AbstractCacheEntry* lookup(Addr address) const;
@@ -150,6 +159,7 @@ class CacheMemory : public SimObject
     Stats::Vector m_accessModeType;
 
     Stats::Scalar m_deallocated;
+    Stats::Scalar m_stream_way_allocated;
     // No reuse also means data is evicted clean.
     Stats::Scalar m_deallocated_no_reuse;
     Stats::Scalar m_deallocated_no_reuse_no_req_stat;
@@ -183,6 +193,15 @@ class CacheMemory : public SimObject
     int findTagInSet(int64_t line, Addr tag) const;
     int findTagInSetIgnorePermissions(int64_t cacheSet, Addr tag) const;
 
+    // Ways [begin, end) that the normal or stream line can use.
+    int wayBegin(bool isStream) const;
+    int wayEnd(bool isStream) const;
+    bool cacheAvailInWays(Addr address, bool isStream) const;
+    AbstractCacheEntry* allocateInWays(Addr address,
+                                       AbstractCacheEntry* entry,
+                                       bool isStream);
+    Addr cacheProbeInWays(Addr address, bool isStream) const;
+
     // Private copy constructor and assignment operator
     CacheMemory(const CacheMemory& obj);
     CacheMemory& operator=(const CacheMemory& obj);
@@ -215,6 +234,7 @@ class CacheMemory : public SimObject
     bool m_resource_stalls;
     int m_block_size;
     bool m_query_stream_nuca;
+    int m_num_stream_ways;
 
     /**
      * We store all the ReplacementData in a 2-dimensional array. By doing
@@ -55,4 +55,9 @@ class RubyCache(SimObject):
 
     # ! Sean: Stream NUCA.
     # Whether we should query StreamNUCAMap for remapped set.
-    query_stream_nuca = Param.Bool(False, "query StreamNUCA for set.")
\ No newline at end of file
+    query_stream_nuca = Param.Bool(False, "query StreamNUCA for set.")
+
+    # ! Sean: Stream-Aware Cache.
+    # Reserve the last ways as the stream buffer. Stream lines are only
+    # allocated in these ways, and other lines never use them.
+    num_stream_ways = Param.Int(0, "num ways reserved for streams.")
\ No newline at end of file
@@ -1177,6 +1177,7 @@ $c_ident::functionalReadBuffers(PacketPtr& pkt)
 #include <cassert>
 #include <typeinfo>
 
+#include "base/host_profile.hh"
 #include "base/logging.hh"
 
 ''')
@@ -1208,9 +1209,12 @@ $c_ident::functionalReadBuffers(PacketPtr& pkt)
 
 using namespace std;
 
+HOST_PROFILE_COUNTER(hostProfileWakeup, "ruby.${ident}.wakeup");
+
 void
 ${ident}_Controller::wakeup()
 {
+    HOST_PROFILE_SCOPE(hostProfileWakeup);
     if (getMemReqQueue() && getMemReqQueue()->isReady(clockEdge())) {
         serviceMemoryQueue();
     }
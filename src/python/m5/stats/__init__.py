@@ -149,6 +149,29 @@ def _textFactory(fn, desc=True, dumpAll=False):
 
     return _m5.stats.initText(fn, desc, dumpAll)
 
+@_url_factory([ "bin", ])
+def _binaryFactory(fn, delta=True, compress=True, keyframe=64,
+                   formulas=False):
+    """Output stats in a columnar binary format.
+
+    The stat names are written once, then each dump appends a row of
+    doubles, which is much cheaper than formatting text and makes frequent
+    periodic dumps practical. Use util/stats/binary_stats.py to read it.
+
+    Parameters:
+      * delta (bool): XOR each row with the previous one (default: True)
+      * compress (bool): Compress each row with zlib (default: True)
+      * keyframe (unsigned): Store a full row every this many dumps
+        (default: 64)
+      * formulas (bool): Output derived stats (default: False)
+
+    Example:
+      bin://stats.bin?keyframe=16;formulas=True
+
+    """
+
+    return _m5.stats.initBinary(fn, delta, compress, keyframe, formulas)
+
 @_url_factory([ "h5", ], enable=hasattr(_m5.stats, "initHDF5"))
 def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
     """Output stats in HDF5 format.
@@ -73,11 +73,29 @@ class Process(SimObject):
         "switch cpu when encounter this mark")
     markEnd = Param.Int64(-1,
         "end when encounter this mark")
+    markSamplePeriod = Param.Int64(-1,
+        "sample every this number of marks, -1 to disable sampling")
+    markSampleWarmup = Param.UInt64(0,
+        "number of detailed warm up marks at the start of each sample")
+    markSampleDetail = Param.UInt64(1,
+        "number of measured marks in each sample after warm up")
     enableStreamNUCA = Param.Bool(False, "Enable Stream NUCA.")
     streamNUCAIndPageRemapPolicy = Param.String('closest',
         "Remap indirect page to which bank.")
     streamNUCAIndPageRemapThreshold = Param.Float(0.0,
         "Remap indirect page if achieve traffic reduction. 0 always remap")
+    streamNUCARemapThreads = Param.Int(0,
+        "Host threads to remap indirect region. 0 uses all host cores.")
+    streamNUCAOnlineMigrate = Param.Bool(False,
+        "Migrate indirect pages online with sampled LLC stream traffic.")
+    streamNUCAOnlineMigrateInterval = Param.UInt64(100000,
+        "Sampled indirect accesses between online migration.")
+    streamNUCAOnlineMigrateMaxPages = Param.Int(64,
+        "Max pages migrated online at a time (negative for no limit).")
+    streamNUCAOnlineMigrateCopyLatency = Param.Latency('1ns',
+        "Latency to copy one cache line of a migrated page.")
+    streamNUCASetPolicy = Param.String('footprint',
+        "How to assign LLC start set to aligned regions (footprint|stagger).")
 
     @classmethod
     def export_methods(cls, code):
@@ -34,6 +34,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "base/host_profile.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "cpu/smt.hh"
@@ -192,9 +193,12 @@ EventQueue::remove(Event *event)
     prev->nextBin = Event::removeItem(event, curr);
 }
 
+HOST_PROFILE_COUNTER(hostProfileServiceOne, "eventq.serviceOne");
+
 Event *
 EventQueue::serviceOne()
 {
+    HOST_PROFILE_SCOPE(hostProfileServiceOne);
     std::lock_guard<EventQueue> lock(*this);
     Event *event = head;
     Event *next = head->nextInBin;
@@ -154,6 +154,18 @@ Process::Process(ProcessParams *params, EmulationPageTable *pTable,
      */
     _tgid = params->pid;
 
+    if (params->markSamplePeriod > 0) {
+        fatal_if(params->markSwitchcpu != -1,
+                 "Work mark sampling does not support markSwitchcpu.");
+        fatal_if(params->markSampleDetail == 0,
+                 "Work mark sampling needs at least one detail mark.");
+        fatal_if(params->markSampleWarmup + params->markSampleDetail >=
+                     params->markSamplePeriod,
+                 "Work mark sample warmup %llu + detail %llu >= period %lld.",
+                 params->markSampleWarmup, params->markSampleDetail,
+                 params->markSamplePeriod);
+    }
+
     exitGroup = new bool(params->exitGroup);
     sigchld = new bool();
 
@@ -172,7 +184,13 @@ Process::Process(ProcessParams *params, EmulationPageTable *pTable,
     this->streamNUCAManager = std::make_shared<StreamNUCAManager>(
         this, params->enableStreamNUCA,
         params->streamNUCAIndPageRemapPolicy,
-        params->streamNUCAIndPageRemapThreshold);
+        params->streamNUCAIndPageRemapThreshold,
+        params->streamNUCARemapThreads,
+        params->streamNUCAOnlineMigrate,
+        params->streamNUCAOnlineMigrateInterval,
+        params->streamNUCAOnlineMigrateMaxPages,
+        params->streamNUCAOnlineMigrateCopyLatency,
+        params->streamNUCASetPolicy);
 }
 
 void
@@ -390,6 +408,7 @@ Process::serialize(CheckpointOut &cp) const
 {
     memState->serialize(cp);
     pTable->serialize(cp);
+    streamNUCAManager->serialize(cp);
     /**
      * Checkpoints for file descriptors currently do not work. Need to
      * come back and fix them at a later date.
@@ -403,6 +422,7 @@ Process::unserialize(CheckpointIn &cp)
 {
     memState->unserialize(cp);
     pTable->unserialize(cp);
+    streamNUCAManager->unserialize(cp);
     /**
      * Checkpoints for file descriptors currently do not work. Need to
      * come back and fix them at a later date.
@@ -574,6 +594,18 @@ Process::encounterWorkMark(uint64_t markId) {
             }
         }
     }
+    // Sampled simulation: each period starts with the warm up in detail,
+    // then the measured marks, and fast forwards for the rest.
+    if (p->markSamplePeriod > 0) {
+        uint64_t offset = this->workMarkIndex % p->markSamplePeriod;
+        if (offset == 0) {
+            exitSimLoop("marksamplestart", static_cast<int>(markId));
+        } else if (offset == p->markSampleWarmup) {
+            exitSimLoop("marksampledetail", static_cast<int>(markId));
+        } else if (offset == p->markSampleWarmup + p->markSampleDetail) {
+            exitSimLoop("marksampleend", static_cast<int>(markId));
+        }
+    }
     if (p->markEnd != -1 && this->workMarkIndex == p->markEnd) {
         exitSimLoop("markend", static_cast<int>(markId));
     }
@@ -48,8 +48,12 @@
 #include <fstream>
 #include <iostream>
 #include <list>
+#include <memory>
+#include <vector>
 
 #include "base/callback.hh"
+#include "base/cprintf.hh"
+#include "base/host_profile.hh"
 #include "base/hostinfo.hh"
 #include "base/statistics.hh"
 #include "base/time.hh"
@@ -103,6 +107,16 @@ statFinalTick()
 
 SimTicksReset simTicksReset;
 
+struct HostProfileReset : public Callback
+{
+    void process()
+    {
+        HostProfile::resetCounters();
+    }
+};
+
+HostProfileReset hostProfileReset;
+
 struct Global
 {
     Stats::Formula hostInstRate;
@@ -114,7 +128,13 @@ struct Global
     Stats::Value simInsts;
     Stats::Value simOps;
 
+    /** Calls, cycles and self cycles of each host profile counter. */
+    std::vector<std::unique_ptr<Stats::Value>> hostProfile;
+
     Global();
+
+  private:
+    void regHostProfile();
 };
 
 Global::Global()
@@ -199,6 +219,36 @@ Global::Global()
     hostTickRate = simTicks / hostSeconds;
 
     registerResetCallback(&simTicksReset);
+
+    // Empty unless built with HOST_PROFILE.
+    regHostProfile();
+}
+
+void
+Global::regHostProfile()
+{
+    for (auto counter : HostProfile::counters()) {
+        std::string prefix = csprintf("host_profile.%s", counter->name);
+        hostProfile.emplace_back(new Stats::Value());
+        hostProfile.back()->scalar(counter->calls)
+            .name(prefix + ".calls")
+            .desc("Number of calls of the profiled scope")
+            .precision(0)
+            ;
+        hostProfile.emplace_back(new Stats::Value());
+        hostProfile.back()->scalar(counter->cycles)
+            .name(prefix + ".cycles")
+            .desc("Host cycles in the profiled scope, including nested ones")
+            .precision(0)
+            ;
+        hostProfile.emplace_back(new Stats::Value());
+        hostProfile.back()->scalar(counter->selfCycles)
+            .name(prefix + ".self_cycles")
+            .desc("Host cycles in the profiled scope, excluding nested ones")
+            .precision(0)
+            ;
+    }
+    registerResetCallback(&hostProfileReset);
 }
 
 void
@@ -55,6 +55,40 @@ void NUMAPageAllocator::returnPage(Addr pagePAddr, int nodeId) {
           nodeId, queueId);
 }
 
+void NUMAPageAllocator::serialize(CheckpointOut &cp) {
+  ScopedCheckpointSection sec(cp, "numaPageAllocator");
+  paramOut(cp, "initialized", initialized);
+  if (!initialized) {
+    return;
+  }
+  paramOut(cp, "freePages.size", freePages.size());
+  for (size_t i = 0; i < freePages.size(); ++i) {
+    std::vector<Addr> queue(freePages[i].begin(), freePages[i].end());
+    arrayParamOut(cp, csprintf("freePages%d", i), queue);
+  }
+}
+
+void NUMAPageAllocator::unserialize(System *system, CheckpointIn &cp) {
+  ScopedCheckpointSection sec(cp, "numaPageAllocator");
+  bool wasInitialized;
+  paramIn(cp, "initialized", wasInitialized);
+  if (!wasInitialized) {
+    return;
+  }
+  initialize(system);
+  size_t numQueues;
+  paramIn(cp, "freePages.size", numQueues);
+  if (numQueues != freePages.size()) {
+    fatal("Mismatch in NUMAPageAllocator checkpoint: %d queues but %d nodes.",
+          numQueues, freePages.size());
+  }
+  for (size_t i = 0; i < numQueues; ++i) {
+    std::vector<Addr> queue;
+    arrayParamIn(cp, csprintf("freePages%d", i), queue);
+    freePages[i].assign(queue.begin(), queue.end());
+  }
+}
+
 void NUMAPageAllocator::initialize(System *system) {
   if (NUMAPageAllocator::initialized) {
     assert(system == NUMAPageAllocator::system &&
@@ -2,6 +2,7 @@
 #define __GEM_FORGE_NUMA_PAGE_ALLOCATOR_HH__
 
 #include "base/types.hh"
+#include "sim/serialize.hh"
 
 #include <deque>
 #include <vector>
@@ -26,6 +27,13 @@ public:
                              int &allocNodeId);
   static void returnPage(Addr pagePAddr, int nodeId);
 
+  /**
+   * Save/restore the free pages. They are already allocated from the system,
+   * so they would be leaked if not restored.
+   */
+  static void serialize(CheckpointOut &cp);
+  static void unserialize(System *system, CheckpointIn &cp);
+
 private:
   static bool initialized;
   static System *system;
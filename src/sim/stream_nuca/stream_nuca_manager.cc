@@ -3,12 +3,19 @@
 #include "stream_nuca_map.hh"
 
 #include "base/trace.hh"
+#include "arch/generic/tlb.hh"
+#include "base/output.hh"
 #include "cpu/thread_context.hh"
+#include "sim/system.hh"
 
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
+#include <thread>
 #include <unordered_set>
 
 #include "debug/StreamNUCAManager.hh"
+#include "debug/StreamNUCAMap.hh"
 
 bool StreamNUCAManager::statsRegsiterd = false;
 Stats::ScalarNoReset StreamNUCAManager::indRegionPages;
@@ -21,13 +28,29 @@ Stats::ScalarNoReset StreamNUCAManager::indRegionMemToLLCRemappedHops;
 Stats::DistributionNoReset StreamNUCAManager::indRegionMemRemappedBanks;
 Stats::ScalarNoReset StreamNUCAManager::indRegionMemToLLCFinalHops;
 Stats::DistributionNoReset StreamNUCAManager::indRegionMemFinalBanks;
+Stats::ScalarNoReset StreamNUCAManager::indRegionRemapWallTime;
+Stats::ScalarNoReset StreamNUCAManager::onlineMigrateEpochs;
+Stats::ScalarNoReset StreamNUCAManager::onlineMigrateBlockedAttempts;
+Stats::ScalarNoReset StreamNUCAManager::onlineMigrateSampledPages;
+Stats::ScalarNoReset StreamNUCAManager::onlineMigratePages;
+Stats::ScalarNoReset StreamNUCAManager::onlineMigrateDefaultHops;
+Stats::ScalarNoReset StreamNUCAManager::onlineMigrateRemappedHops;
+Stats::ScalarNoReset StreamNUCAManager::onlineMigrateCopyTicks;
+Stats::ScalarNoReset StreamNUCAManager::alignGroupSetSamples;
+Stats::ScalarNoReset StreamNUCAManager::alignGroupSetConflicts;
 
 StreamNUCAManager::StreamNUCAManager(
     Process *_process, bool _enabled,
     const std::string &_indirectPageRemapPolicy,
-    float _indirectPageRemapThreshold)
+    float _indirectPageRemapThreshold, int _remapThreads, bool _onlineMigrate,
+    uint64_t _onlineMigrateInterval, int _onlineMigrateMaxPages,
+    Tick _onlineMigrateCopyLatency, const std::string &_cacheSetPolicy)
     : process(_process), enabled(_enabled),
-      indirectPageRemapThreshold(_indirectPageRemapThreshold) {
+      indirectPageRemapThreshold(_indirectPageRemapThreshold),
+      remapThreads(_remapThreads), onlineMigrate(_onlineMigrate),
+      onlineMigrateInterval(_onlineMigrateInterval),
+      onlineMigrateMaxPages(_onlineMigrateMaxPages),
+      onlineMigrateCopyLatency(_onlineMigrateCopyLatency) {
   if (_indirectPageRemapPolicy == "closest") {
     this->indirectPageRemapPolicy = IndirectPageRemapPolicy::CLOESEST;
   } else if (_indirectPageRemapPolicy == "tile") {
@@ -35,12 +58,24 @@ StreamNUCAManager::StreamNUCAManager(
   } else {
     panic("Unknown IndirectPageRemapPolicy %s.", _indirectPageRemapPolicy);
   }
+  if (_cacheSetPolicy == "footprint") {
+    this->cacheSetPolicy = CacheSetPolicy::FOOTPRINT;
+  } else if (_cacheSetPolicy == "stagger") {
+    this->cacheSetPolicy = CacheSetPolicy::STAGGER;
+  } else {
+    panic("Unknown CacheSetPolicy %s.", _cacheSetPolicy);
+  }
 }
 
 StreamNUCAManager::StreamNUCAManager(const StreamNUCAManager &other)
     : process(other.process), enabled(other.enabled),
       indirectPageRemapPolicy(other.indirectPageRemapPolicy),
-      indirectPageRemapThreshold(other.indirectPageRemapThreshold) {
+      cacheSetPolicy(other.cacheSetPolicy),
+      indirectPageRemapThreshold(other.indirectPageRemapThreshold),
+      remapThreads(other.remapThreads), onlineMigrate(other.onlineMigrate),
+      onlineMigrateInterval(other.onlineMigrateInterval),
+      onlineMigrateMaxPages(other.onlineMigrateMaxPages),
+      onlineMigrateCopyLatency(other.onlineMigrateCopyLatency) {
   panic("StreamNUCAManager does not have copy constructor.");
 }
 
@@ -80,6 +115,23 @@ void StreamNUCAManager::regStats() {
          "Optimized hops from Mem to LLC in indirect retion.");
   scalar(indRegionMemToLLCFinalHops,
          "Optimized hops from Mem to LLC in indirect retion.");
+  scalar(indRegionRemapWallTime,
+         "Host seconds spent to remap indirect region.");
+  scalar(onlineMigrateEpochs, "Online migration epochs.");
+  scalar(onlineMigrateBlockedAttempts,
+         "Pending online migration delayed as the system is not quiesced.");
+  scalar(onlineMigrateSampledPages,
+         "Pages sampled by LLC streams for online migration.");
+  scalar(onlineMigratePages, "Pages migrated online.");
+  scalar(onlineMigrateDefaultHops,
+         "Sampled hops of online migrated pages before migration.");
+  scalar(onlineMigrateRemappedHops,
+         "Sampled hops of online migrated pages after migration.");
+  scalar(onlineMigrateCopyTicks, "Ticks charged to copy migrated pages.");
+  scalar(alignGroupSetSamples,
+         "Sampled elements of aligned regions to check set conflict.");
+  scalar(alignGroupSetConflicts,
+         "Sampled elements mapped to the same LLC set as an aligned region.");
 
   auto numMemNodes = StreamNUCAMap::getNUMANodes().size();
   distribution(indRegionMemOptimizedBanks, 0, numMemNodes - 1, 1,
@@ -114,6 +166,75 @@ void StreamNUCAManager::defineAlign(Addr A, Addr B, int64_t elementOffset) {
   }
 }
 
+void StreamNUCAManager::serialize(CheckpointOut &cp) const {
+  ScopedCheckpointSection sec(cp, "streamNUCAManager");
+  paramOut(cp, "regions.size", this->startVAddrRegionMap.size());
+  size_t regionIdx = 0;
+  for (const auto &entry : this->startVAddrRegionMap) {
+    const auto &region = entry.second;
+    ScopedCheckpointSection regionSec(cp, csprintf("Region%d", regionIdx++));
+    paramOut(cp, "name", region.name);
+    paramOut(cp, "vaddr", region.vaddr);
+    paramOut(cp, "elementSize", region.elementSize);
+    paramOut(cp, "numElement", region.numElement);
+    paramOut(cp, "isIndirect", region.isIndirect);
+    std::vector<Addr> alignVAddrBs;
+    std::vector<int64_t> alignElementOffsets;
+    for (const auto &align : region.aligns) {
+      alignVAddrBs.push_back(align.vaddrB);
+      alignElementOffsets.push_back(align.elementOffset);
+    }
+    arrayParamOut(cp, "alignVAddrBs", alignVAddrBs);
+    arrayParamOut(cp, "alignElementOffsets", alignElementOffsets);
+  }
+  StreamNUCAMap::serialize(cp);
+  NUMAPageAllocator::serialize(cp);
+}
+
+void StreamNUCAManager::unserialize(CheckpointIn &cp) {
+  ScopedCheckpointSection sec(cp, "streamNUCAManager");
+  // The manager is shared by all threads, each restoring the same regions.
+  this->startVAddrRegionMap.clear();
+  this->onlinePages.clear();
+  this->onlineSamples = 0;
+  this->onlineMigratePending = false;
+  size_t numRegions;
+  paramIn(cp, "regions.size", numRegions);
+  for (size_t i = 0; i < numRegions; ++i) {
+    ScopedCheckpointSection regionSec(cp, csprintf("Region%d", i));
+    std::string name;
+    Addr vaddr;
+    uint64_t elementSize;
+    uint64_t numElement;
+    bool isIndirect;
+    UNSERIALIZE_SCALAR(name);
+    UNSERIALIZE_SCALAR(vaddr);
+    UNSERIALIZE_SCALAR(elementSize);
+    UNSERIALIZE_SCALAR(numElement);
+    UNSERIALIZE_SCALAR(isIndirect);
+    std::vector<Addr> alignVAddrBs;
+    std::vector<int64_t> alignElementOffsets;
+    arrayParamIn(cp, "alignVAddrBs", alignVAddrBs);
+    arrayParamIn(cp, "alignElementOffsets", alignElementOffsets);
+    assert(alignVAddrBs.size() == alignElementOffsets.size());
+    auto &region =
+        this->startVAddrRegionMap
+            .emplace(std::piecewise_construct, std::forward_as_tuple(vaddr),
+                     std::forward_as_tuple(name, vaddr, elementSize,
+                                           numElement))
+            .first->second;
+    region.isIndirect = isIndirect;
+    for (size_t j = 0; j < alignVAddrBs.size(); ++j) {
+      region.aligns.emplace_back(vaddr, alignVAddrBs[j],
+                                 alignElementOffsets[j]);
+    }
+    DPRINTF(StreamNUCAManager, "Restore Region %s %#x %lu %lu Aligns %d.\n",
+            name, vaddr, elementSize, numElement, region.aligns.size());
+  }
+  StreamNUCAMap::unserialize(cp);
+  NUMAPageAllocator::unserialize(this->process->system, cp);
+}
+
 const StreamNUCAManager::StreamRegion &
 StreamNUCAManager::getContainingStreamRegion(Addr vaddr) const {
   auto iter = this->startVAddrRegionMap.upper_bound(vaddr);
@@ -274,6 +395,8 @@ void StreamNUCAManager::remapIndirectRegion(ThreadContext *tc,
   const auto &align = region.aligns.front();
   assert(align.vaddrB != region.vaddr && "Self-IndirectAlign?");
 
+  auto startTime = std::chrono::steady_clock::now();
+
   /**
    * Scan through the indirect regions and collect outgoing banks.
    * Then remap each page to reduce traffic.
@@ -287,113 +410,115 @@ void StreamNUCAManager::remapIndirectRegion(ThreadContext *tc,
           region.name, region.vaddr);
   }
   const auto &alignToRegion = this->getRegionFromStartVAddr(align.vaddrB);
-  for (Addr vaddr = region.vaddr; vaddr < endVAddr; vaddr += pageSize) {
-    auto pageVAddr = pTable->pageAlign(vaddr);
-    this->remapIndirectPage(tc, region, alignToRegion, pageVAddr);
+
+  /**
+   * The page table and the ruby functional accesses are not thread safe,
+   * so everything that touches them stays in this thread:
+   * 1. Translate the AlignToRegion and read a batch of pages.
+   * 2. Count the AlignToBank frequency of the batch in parallel.
+   * 3. Remap the pages in order.
+   */
+  this->initNUMABankHops();
+  StreamNUCAMap::buildLookupTable();
+  std::vector<Addr> alignToPagePAddrs;
+  {
+    auto alignToEndVAddr = alignToRegion.vaddr + alignToRegion.elementSize *
+                                                     alignToRegion.numElement;
+    for (auto vaddr = pTable->pageAlign(alignToRegion.vaddr);
+         vaddr < alignToEndVAddr; vaddr += pageSize) {
+      alignToPagePAddrs.push_back(this->translate(vaddr));
+    }
+  }
+
+  auto numThreads = this->getRemapThreads();
+  auto numPages = (totalSize + pageSize - 1) / pageSize;
+  auto batchPages = std::min(
+      numPages, static_cast<uint64_t>(numThreads * RemapBatchPagesPerThread));
+  auto numBanks = StreamNUCAMap::getNumRows() * StreamNUCAMap::getNumCols();
+
+  // Reused across batches.
+  std::vector<char> batchData(batchPages * pageSize);
+  std::vector<IndirectPage> batch(batchPages);
+  for (auto &page : batch) {
+    page.alignToBankFrequency.resize(numBanks);
+    page.chunkAlignToBankFrequency.resize(this->numaChunksPerPage * numBanks);
+  }
+
+  for (uint64_t batchStart = 0; batchStart < numPages;
+       batchStart += batchPages) {
+    auto batchSize = std::min(batchPages, numPages - batchStart);
+    for (uint64_t i = 0; i < batchSize; ++i) {
+      auto &page = batch[i];
+      page.vaddr = region.vaddr + (batchStart + i) * pageSize;
+      page.paddr = this->translate(page.vaddr);
+      page.numBytes = std::min(endVAddr, page.vaddr + pageSize) - page.vaddr;
+      page.data = batchData.data() + i * pageSize;
+      std::fill(page.alignToBankFrequency.begin(),
+                page.alignToBankFrequency.end(), 0);
+      std::fill(page.chunkAlignToBankFrequency.begin(),
+                page.chunkAlignToBankFrequency.end(), 0);
+      tc->getVirtProxy().readBlob(page.vaddr, page.data, pageSize);
+    }
+
+    auto computeFreq = [&](int threadId) -> void {
+      for (uint64_t i = threadId; i < batchSize; i += numThreads) {
+        auto &page = batch[i];
+        this->computeAlignToBankFreq(region, alignToRegion, alignToPagePAddrs,
+                                     page);
+      }
+    };
+    if (numThreads == 1 || batchSize == 1) {
+      computeFreq(0);
+    } else {
+      std::vector<std::thread> threads;
+      for (int threadId = 1; threadId < numThreads; ++threadId) {
+        threads.emplace_back(computeFreq, threadId);
+      }
+      computeFreq(0);
+      for (auto &thread : threads) {
+        thread.join();
+      }
+    }
+
+    for (uint64_t i = 0; i < batchSize; ++i) {
+      this->remapIndirectPage(tc, region, alignToRegion, batch[i]);
+    }
   }
+
+  auto endTime = std::chrono::steady_clock::now();
+  indRegionRemapWallTime +=
+      std::chrono::duration<double>(endTime - startTime).count();
 }
 
 void StreamNUCAManager::remapIndirectPage(ThreadContext *tc,
                                           const StreamRegion &region,
                                           const StreamRegion &alignToRegion,
-                                          Addr pageVAddr) {
+                                          const IndirectPage &page) {
   auto pTable = this->process->pTable;
   auto pageSize = pTable->getPageSize();
-  auto totalSize = region.elementSize * region.numElement;
-  auto endVAddr = std::min(region.vaddr + totalSize, pageVAddr + pageSize);
-  auto numBytes = endVAddr - pageVAddr;
+  auto pageVAddr = page.vaddr;
+  auto pagePAddr = page.paddr;
+  auto numBytes = page.numBytes;
   auto pageIndex = (pageVAddr - region.vaddr) / pageSize;
-  auto pagePAddr = this->translate(pageVAddr);
   auto defaultNodeId = StreamNUCAMap::mapPAddrToNUMAId(pagePAddr);
-
-  char *pageData = reinterpret_cast<char *>(malloc(pageSize));
-  tc->getVirtProxy().readBlob(pageVAddr, pageData, pageSize);
+  const auto &alignToBankFrequency = page.alignToBankFrequency;
 
   indRegionPages++;
   indRegionElements += numBytes / region.elementSize;
 
-  /**
-   * Read each element and count the frequency of AlignToBank.
-   */
   auto numRows = StreamNUCAMap::getNumRows();
   auto numCols = StreamNUCAMap::getNumCols();
-  std::vector<int32_t> alignToBankFrequency(numRows * numCols, 0);
 
   DPRINTF(StreamNUCAManager,
           "[StreamNUCA] IndirectAlign %s -> %s PageIndex %lu.\n", region.name,
           alignToRegion.name, pageIndex);
 
-  auto defaultHops =
-      this->computeHopsAndFreq(region, alignToRegion, pageVAddr, numBytes,
-                               pageData, alignToBankFrequency);
+  auto defaultHops = this->computePageHops(pagePAddr, page);
   indRegionMemToLLCDefaultHops += defaultHops;
 
-  const auto &numaNodes = StreamNUCAMap::getNUMANodes();
-  int selectedNUMANode = -1;
   int selectedBank = -1;
-  int64_t selectedNUMANodeTraffic = 0;
-  if (this->indirectPageRemapPolicy == IndirectPageRemapPolicy::CLOESEST) {
-    /**
-     * For all valid NUMA nodes, select the one has lowest traffic.
-     */
-    for (int i = 0; i < numaNodes.size(); ++i) {
-      const auto &numaNode = numaNodes.at(i);
-      int64_t traffic = 0;
-      for (int bank = 0; bank < alignToBankFrequency.size(); ++bank) {
-        traffic += StreamNUCAMap::computeHops(bank, numaNode.routerId) *
-                   alignToBankFrequency.at(bank);
-      }
-      DPRINTF(StreamNUCAManager, "  NUMA %d Router %d Traffic %ld.\n", i,
-              numaNode.routerId, traffic);
-      if (selectedNUMANode == -1 || traffic < selectedNUMANodeTraffic) {
-        selectedNUMANode = i;
-        selectedBank = numaNode.routerId;
-        selectedNUMANodeTraffic = traffic;
-      }
-    }
-  } else if (this->indirectPageRemapPolicy == IndirectPageRemapPolicy::TILE) {
-    /**
-     * First find the bank with highest frequency, then pick the memory
-     * controller in that tile.
-     * This is used to avoid heavy load imbalance.
-     */
-    int maxFreq = 0;
-    int maxFreqBank = 0;
-    for (int bank = 0; bank < alignToBankFrequency.size(); ++bank) {
-      auto freq = alignToBankFrequency.at(bank);
-      if (freq > maxFreq) {
-        maxFreq = freq;
-        maxFreqBank = bank;
-      }
-    }
-    // Search for the NUCA node handling this bank.
-    for (int i = 0; i < numaNodes.size(); ++i) {
-      const auto &numaNode = numaNodes.at(i);
-      for (const auto &handleBank : numaNode.handleBanks) {
-        if (handleBank == maxFreqBank) {
-          // Compute the traffic.
-          int64_t traffic = 0;
-          for (int bank = 0; bank < alignToBankFrequency.size(); ++bank) {
-            traffic += StreamNUCAMap::computeHops(bank, numaNode.routerId) *
-                       alignToBankFrequency.at(bank);
-          }
-          selectedNUMANode = i;
-          selectedBank = numaNode.routerId;
-          selectedNUMANodeTraffic = traffic;
-          break;
-        }
-      }
-      if (selectedNUMANode != -1) {
-        break;
-      }
-    }
-    if (selectedNUMANode == -1) {
-      panic("Failed to find NUMANode for MaxFreqBank %d.", maxFreqBank);
-    }
-
-  } else {
-    assert(false && "Unsupported IndirectPageRemapPolicy.");
-  }
+  int selectedNUMANode =
+      this->selectNUMANode(alignToBankFrequency, selectedBank);
 
   if (Debug::StreamNUCAManager) {
     int32_t avgBankFreq =
@@ -426,13 +551,10 @@ void StreamNUCAManager::remapIndirectPage(ThreadContext *tc,
 
   bool clobber = true;
   pTable->map(pageVAddr, newPagePAddr, pageSize, clobber);
-  tc->getVirtProxy().writeBlob(pageVAddr, pageData, pageSize);
+  tc->getVirtProxy().writeBlob(pageVAddr, page.data, pageSize);
 
   // Compute the optimized hops. The frequence should not change.
-  std::vector<int32_t> optimizedAlignToBankFrequency(numRows * numCols, 0);
-  auto remapHops =
-      this->computeHopsAndFreq(region, alignToRegion, pageVAddr, numBytes,
-                               pageData, optimizedAlignToBankFrequency);
+  auto remapHops = this->computePageHops(newPagePAddr, page);
   indRegionMemToLLCRemappedHops += remapHops;
 
   /**
@@ -463,26 +585,91 @@ void StreamNUCAManager::remapIndirectPage(ThreadContext *tc,
     indRegionMemToLLCFinalHops += remapHops;
     indRegionMemFinalBanks.sample(allocNodeId, 1);
   }
+}
+
+int StreamNUCAManager::selectNUMANode(
+    const std::vector<int32_t> &alignToBankFrequency, int &selectedBank) const {
+  const auto &numaNodes = StreamNUCAMap::getNUMANodes();
+  int selectedNUMANode = -1;
+  int64_t selectedNUMANodeTraffic = 0;
+  if (this->indirectPageRemapPolicy == IndirectPageRemapPolicy::CLOESEST) {
+    /**
+     * For all valid NUMA nodes, select the one has lowest traffic.
+     */
+    for (int i = 0; i < numaNodes.size(); ++i) {
+      const auto &numaNode = numaNodes.at(i);
+      int64_t traffic = this->computeHops(i, alignToBankFrequency.data());
+      DPRINTF(StreamNUCAManager, "  NUMA %d Router %d Traffic %ld.\n", i,
+              numaNode.routerId, traffic);
+      if (selectedNUMANode == -1 || traffic < selectedNUMANodeTraffic) {
+        selectedNUMANode = i;
+        selectedBank = numaNode.routerId;
+        selectedNUMANodeTraffic = traffic;
+      }
+    }
+  } else if (this->indirectPageRemapPolicy == IndirectPageRemapPolicy::TILE) {
+    /**
+     * First find the bank with highest frequency, then pick the memory
+     * controller in that tile.
+     * This is used to avoid heavy load imbalance.
+     */
+    int maxFreq = 0;
+    int maxFreqBank = 0;
+    for (int bank = 0; bank < alignToBankFrequency.size(); ++bank) {
+      auto freq = alignToBankFrequency.at(bank);
+      if (freq > maxFreq) {
+        maxFreq = freq;
+        maxFreqBank = bank;
+      }
+    }
+    // Search for the NUCA node handling this bank.
+    for (int i = 0; i < numaNodes.size(); ++i) {
+      const auto &numaNode = numaNodes.at(i);
+      for (const auto &handleBank : numaNode.handleBanks) {
+        if (handleBank == maxFreqBank) {
+          // Compute the traffic.
+          selectedNUMANode = i;
+          selectedBank = numaNode.routerId;
+          selectedNUMANodeTraffic =
+              this->computeHops(i, alignToBankFrequency.data());
+          break;
+        }
+      }
+      if (selectedNUMANode != -1) {
+        break;
+      }
+    }
+    if (selectedNUMANode == -1) {
+      panic("Failed to find NUMANode for MaxFreqBank %d.", maxFreqBank);
+    }
 
-  free(pageData);
+  } else {
+    assert(false && "Unsupported IndirectPageRemapPolicy.");
+  }
+  return selectedNUMANode;
 }
 
-int64_t StreamNUCAManager::computeHopsAndFreq(
+void StreamNUCAManager::computeAlignToBankFreq(
     const StreamRegion &region, const StreamRegion &alignToRegion,
-    Addr pageVAddr, int64_t numBytes, char *pageData,
-    std::vector<int32_t> &alignToBankFrequency) {
+    const std::vector<Addr> &alignToPagePAddrs, IndirectPage &page) {
 
-  auto pageSize = this->process->pTable->getPageSize();
-  auto pageIndex = (pageVAddr - region.vaddr) / pageSize;
-
-  int64_t traffic = 0;
+  /**
+   * This runs in the worker threads. It must not touch the page table, and
+   * only reads the translation of AlignToRegion from alignToPagePAddrs.
+   */
+  auto pTable = this->process->pTable;
+  auto pageSize = pTable->getPageSize();
+  auto pageIndex = (page.vaddr - region.vaddr) / pageSize;
+  auto alignToStartPageVAddr = pTable->pageAlign(alignToRegion.vaddr);
+  auto &alignToBankFrequency = page.alignToBankFrequency;
+  auto numBanks = alignToBankFrequency.size();
 
-  for (int i = 0; i < numBytes; i += region.elementSize) {
+  for (int i = 0; i < page.numBytes; i += region.elementSize) {
     int64_t index = 0;
     if (region.elementSize == 4) {
-      index = *reinterpret_cast<int32_t *>(pageData + i);
+      index = *reinterpret_cast<int32_t *>(page.data + i);
     } else if (region.elementSize == 8) {
-      index = *reinterpret_cast<int64_t *>(pageData + i);
+      index = *reinterpret_cast<int64_t *>(page.data + i);
     } else {
       panic("[StreamNUCA] Invalid IndrectRegion %s ElementSize %d.",
             region.name, region.elementSize);
@@ -492,30 +679,232 @@ int64_t StreamNUCAManager::computeHopsAndFreq(
             region.name, index, alignToRegion.name, alignToRegion.numElement);
     }
     auto alignToVAddr = alignToRegion.vaddr + index * alignToRegion.elementSize;
-    auto alignToPAddr = this->translate(alignToVAddr);
+    auto alignToPAddr =
+        alignToPagePAddrs[(alignToVAddr - alignToStartPageVAddr) / pageSize] +
+        pTable->pageOffset(alignToVAddr);
     auto alignToBank = StreamNUCAMap::getBank(alignToPAddr);
 
-    // DPRINTF(StreamNUCAManager,
-    //         "  Index %ld AlignToVAddr %#x AlignToPAddr %#x AlignToBank
-    //         %d.\n", index, alignToVAddr, alignToPAddr, alignToBank);
-
     if (alignToBank < 0 || alignToBank >= alignToBankFrequency.size()) {
       panic("[StreamNUCA] IndirectAlign %s -> %s Page %lu Index %ld Invalid "
             "AlignToBank %d.",
             region.name, alignToRegion.name, pageIndex, index, alignToBank);
     }
-    alignToBankFrequency.at(alignToBank)++;
+    alignToBankFrequency[alignToBank]++;
+    auto chunk = i / this->numaChunkBytes;
+    page.chunkAlignToBankFrequency[chunk * numBanks + alignToBank]++;
+  }
+}
+
+void StreamNUCAManager::initNUMABankHops() {
+  if (!this->numaBankHops.empty()) {
+    return;
+  }
+  const auto &numaNodes = StreamNUCAMap::getNUMANodes();
+  auto numBanks = StreamNUCAMap::getNumRows() * StreamNUCAMap::getNumCols();
+  auto pageSize = this->process->pTable->getPageSize();
+  this->numaChunkBytes =
+      std::min(numaNodes.front().addrRange.granularity(), pageSize);
+  this->numaChunksPerPage = pageSize / this->numaChunkBytes;
+  this->numaBankHops.reserve(numaNodes.size() * numBanks);
+  for (const auto &numaNode : numaNodes) {
+    for (int bank = 0; bank < numBanks; ++bank) {
+      this->numaBankHops.push_back(
+          StreamNUCAMap::computeHops(bank, numaNode.routerId));
+    }
+  }
+}
 
-    // Accumulate the default traffic hops.
-    auto elementVAddr = pageVAddr + i;
-    auto elementPAddr = this->translate(elementVAddr);
-    auto elementBank = StreamNUCAMap::mapPAddrToNUMARouterId(elementPAddr);
-    traffic += StreamNUCAMap::computeHops(alignToBank, elementBank);
+int64_t StreamNUCAManager::computeHops(int numaNodeId,
+                                       const int32_t *bankFrequency) const {
+  auto numBanks = StreamNUCAMap::getNumRows() * StreamNUCAMap::getNumCols();
+  const auto *hops = this->numaBankHops.data() + numaNodeId * numBanks;
+  int64_t traffic = 0;
+  for (int bank = 0; bank < numBanks; ++bank) {
+    traffic += hops[bank] * bankFrequency[bank];
   }
+  return traffic;
+}
 
+int64_t StreamNUCAManager::computePageHops(Addr pagePAddr,
+                                           const IndirectPage &page) const {
+  // NUMA nodes may interleave within a page.
+  auto numBanks = page.alignToBankFrequency.size();
+  int64_t traffic = 0;
+  for (int chunk = 0; chunk < this->numaChunksPerPage; ++chunk) {
+    auto nodeId = StreamNUCAMap::mapPAddrToNUMAId(
+        pagePAddr + chunk * this->numaChunkBytes);
+    traffic += this->computeHops(
+        nodeId, page.chunkAlignToBankFrequency.data() + chunk * numBanks);
+  }
   return traffic;
 }
 
+int StreamNUCAManager::getRemapThreads() const {
+  if (Debug::StreamNUCAMap) {
+    // Keep the debug trace in order.
+    return 1;
+  }
+  if (this->remapThreads > 0) {
+    return this->remapThreads;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+const StreamNUCAManager::StreamRegion *
+StreamNUCAManager::findIndirectRegion(Addr vaddr) const {
+  auto iter = this->startVAddrRegionMap.upper_bound(vaddr);
+  if (iter == this->startVAddrRegionMap.begin()) {
+    return nullptr;
+  }
+  iter--;
+  const auto &region = iter->second;
+  if (!region.isIndirect ||
+      region.vaddr + region.elementSize * region.numElement <= vaddr) {
+    return nullptr;
+  }
+  return &region;
+}
+
+void StreamNUCAManager::sampleIndirectAccess(Addr baseVAddr, int targetBank) {
+  if (!this->isOnlineMigrationEnabled()) {
+    return;
+  }
+  if (!this->findIndirectRegion(baseVAddr)) {
+    return;
+  }
+  this->initNUMABankHops();
+  auto pTable = this->process->pTable;
+  auto pageVAddr = pTable->pageAlign(baseVAddr);
+  auto &page = this->onlinePages[pageVAddr];
+  auto numBanks = StreamNUCAMap::getNumRows() * StreamNUCAMap::getNumCols();
+  if (page.alignToBankFrequency.empty()) {
+    page.vaddr = pageVAddr;
+    page.alignToBankFrequency.resize(numBanks, 0);
+    page.chunkAlignToBankFrequency.resize(this->numaChunksPerPage * numBanks,
+                                          0);
+  }
+  assert(targetBank >= 0 && targetBank < numBanks && "Invalid TargetBank.");
+  auto chunk = pTable->pageOffset(baseVAddr) / this->numaChunkBytes;
+  page.alignToBankFrequency[targetBank]++;
+  page.chunkAlignToBankFrequency[chunk * numBanks + targetBank]++;
+
+  this->onlineSamples++;
+  if (this->onlineSamples >= this->onlineMigrateInterval) {
+    this->onlineMigratePending = true;
+  }
+}
+
+bool StreamNUCAManager::tryOnlineMigration(ThreadContext *tc) {
+  if (!this->onlineMigratePending) {
+    return false;
+  }
+  this->onlineMigratePending = false;
+  this->onlineSamples = 0;
+  onlineMigrateEpochs++;
+  onlineMigrateSampledPages += this->onlinePages.size();
+
+  /**
+   * Pick the hottest pages first.
+   */
+  using SampledPage = std::pair<int64_t, IndirectPage *>;
+  std::vector<SampledPage> hotPages;
+  hotPages.reserve(this->onlinePages.size());
+  for (auto &entry : this->onlinePages) {
+    auto &page = entry.second;
+    int64_t samples = 0;
+    for (auto freq : page.alignToBankFrequency) {
+      samples += freq;
+    }
+    hotPages.emplace_back(samples, &page);
+  }
+  std::sort(hotPages.begin(), hotPages.end(),
+            [](const SampledPage &A, const SampledPage &B) -> bool {
+              return A.first > B.first ||
+                     (A.first == B.first && A.second->vaddr < B.second->vaddr);
+            });
+  if (this->onlineMigrateMaxPages >= 0 &&
+      hotPages.size() > static_cast<size_t>(this->onlineMigrateMaxPages)) {
+    hotPages.resize(this->onlineMigrateMaxPages);
+  }
+
+  auto pTable = this->process->pTable;
+  auto pageSize = pTable->getPageSize();
+  std::vector<char> pageData(pageSize);
+  int migratedPages = 0;
+  for (const auto &hotPage : hotPages) {
+    auto page = hotPage.second;
+    auto pagePAddr = this->translate(page->vaddr);
+    auto defaultHops = this->computePageHops(pagePAddr, *page);
+    int selectedBank = -1;
+    auto selectedNUMANode =
+        this->selectNUMANode(page->alignToBankFrequency, selectedBank);
+    if (selectedNUMANode == StreamNUCAMap::mapPAddrToNUMAId(pagePAddr)) {
+      continue;
+    }
+
+    int allocPages = 0;
+    int allocNodeId = 0;
+    auto newPagePAddr = NUMAPageAllocator::allocatePageAt(
+        process->system, selectedNUMANode, allocPages, allocNodeId);
+    indRegionAllocPages += allocPages;
+
+    auto remapHops = this->computePageHops(newPagePAddr, *page);
+    auto reducedHops = std::max(defaultHops - remapHops, 0l);
+    auto reducedHopsRatio =
+        static_cast<float>(reducedHops) / static_cast<float>(defaultHops);
+    DPRINTF(StreamNUCAManager,
+            "[StreamNUCA] Online Page %#x Samples %ld SelectedNUMA %d "
+            "DefaultHops %ld RemapHops %ld ReduceRatio %.2f.\n",
+            page->vaddr, hotPage.first, selectedNUMANode, defaultHops,
+            remapHops, reducedHopsRatio);
+    if (reducedHops == 0 ||
+        reducedHopsRatio < this->indirectPageRemapThreshold) {
+      NUMAPageAllocator::returnPage(newPagePAddr, allocNodeId);
+      continue;
+    }
+
+    /**
+     * Copy the page. The old physical page is not returned, as stale
+     * translations and cached lines may still point to it.
+     */
+    bool clobber = true;
+    tc->getVirtProxy().readBlob(page->vaddr, pageData.data(), pageSize);
+    pTable->map(page->vaddr, newPagePAddr, pageSize, clobber);
+    tc->getVirtProxy().writeBlob(page->vaddr, pageData.data(), pageSize);
+
+    migratedPages++;
+    onlineMigratePages++;
+    onlineMigrateDefaultHops += defaultHops;
+    onlineMigrateRemappedHops += remapHops;
+  }
+  this->onlinePages.clear();
+
+  if (migratedPages == 0) {
+    return false;
+  }
+
+  // Drop the old translations.
+  for (auto threadContext : this->process->system->threadContexts) {
+    threadContext->getDTBPtr()->flushAll();
+    threadContext->getITBPtr()->flushAll();
+  }
+
+  /**
+   * Charge the copy. Pages are copied one line at a time, and following
+   * streams have to wait until it is done.
+   */
+  auto copyLines =
+      migratedPages * (pageSize / StreamNUCAMap::getCacheBlockSize());
+  auto copyTicks = copyLines * this->onlineMigrateCopyLatency;
+  this->onlineMigrateDoneTick =
+      std::max(this->onlineMigrateDoneTick, curTick()) + copyTicks;
+  onlineMigrateCopyTicks += copyTicks;
+  DPRINTF(StreamNUCAManager,
+          "[StreamNUCA] Online Migrated %d Pages, Copy Done at %lu.\n",
+          migratedPages, this->onlineMigrateDoneTick);
+  return true;
+}
+
 void StreamNUCAManager::computeCacheSet() {
 
   /**
@@ -612,15 +1001,27 @@ void StreamNUCAManager::computeCacheSet() {
     }
 
     auto startSet = 0;
+    auto prevElementSize = 0;
     for (auto startVAddr : group) {
       const auto &region = this->getRegionFromStartVAddr(startVAddr);
 
       auto startPAddr = this->translate(startVAddr);
       auto &rangeMap = StreamNUCAMap::getRangeMapByStartPAddr(startPAddr);
+      if (this->cacheSetPolicy == CacheSetPolicy::STAGGER) {
+        /**
+         * Aligned elements are in the same bank, and their set advances with
+         * the element size. Partition the sets by the element size, so that
+         * aligned elements start in disjoint set ranges.
+         */
+        startSet = static_cast<int64_t>(prevElementSize) * llcNumSets /
+                   totalElementSize;
+        prevElementSize += region.elementSize;
+      }
       rangeMap.startSet = startSet;
 
+      // Each set holds llcAssoc lines of this region in every bank.
       auto cachedBytes = cachedElements * region.elementSize;
-      auto usedSets = cachedBytes / (llcBlockSize * totalBanks);
+      auto usedSets = cachedBytes / (llcBlockSize * llcAssoc * totalBanks);
 
       DPRINTF(
           StreamNUCAManager,
@@ -628,9 +1029,85 @@ void StreamNUCAManager::computeCacheSet() {
           "%d.\n",
           region.name, region.vaddr, region.elementSize, cachedElements,
           startSet, usedSets);
-      startSet = (startSet + usedSets) % llcNumSets;
+      if (this->cacheSetPolicy == CacheSetPolicy::FOOTPRINT) {
+        // The next region starts after the sets used by this one.
+        startSet = (startSet + usedSets) % llcNumSets;
+      }
     }
+
+    this->computeSetConflict(group);
+  }
+}
+
+void StreamNUCAManager::computeSetConflict(const std::vector<Addr> &group) {
+  if (group.size() <= 1) {
+    return;
+  }
+
+  /**
+   * Sample aligned elements across the group, and count how many other
+   * regions map the same element to the same bank and set.
+   */
+  uint64_t numElement = 0;
+  for (auto startVAddr : group) {
+    const auto &region = this->getRegionFromStartVAddr(startVAddr);
+    if (numElement == 0 || region.numElement < numElement) {
+      numElement = region.numElement;
+    }
+  }
+  const uint64_t maxSamples = 4096;
+  auto numSamples = std::min(numElement, maxSamples);
+  if (numSamples == 0) {
+    return;
+  }
+
+  std::vector<uint64_t> regionConflicts(group.size(), 0);
+  std::vector<std::pair<int, int>> bankSets(group.size());
+  for (uint64_t sample = 0; sample < numSamples; ++sample) {
+    auto elementIdx = sample * numElement / numSamples;
+    for (int i = 0; i < group.size(); ++i) {
+      const auto &region = this->getRegionFromStartVAddr(group[i]);
+      auto paddr =
+          this->translate(region.vaddr + elementIdx * region.elementSize);
+      bankSets[i].first = StreamNUCAMap::getBank(paddr);
+      bankSets[i].second = StreamNUCAMap::getSet(paddr);
+    }
+    for (int i = 0; i < group.size(); ++i) {
+      for (int j = 0; j < group.size(); ++j) {
+        if (i != j && bankSets[i] == bankSets[j]) {
+          regionConflicts[i]++;
+        }
+      }
+    }
+  }
+
+  auto &log = this->getSetConflictLog();
+  for (int i = 0; i < group.size(); ++i) {
+    const auto &region = this->getRegionFromStartVAddr(group[i]);
+    auto startPAddr = this->translate(region.vaddr);
+    const auto &rangeMap = StreamNUCAMap::getRangeMapByStartPAddr(startPAddr);
+    auto conflictRatio =
+        static_cast<float>(regionConflicts[i]) / static_cast<float>(numSamples);
+    alignGroupSetSamples += numSamples;
+    alignGroupSetConflicts += regionConflicts[i];
+    DPRINTF(StreamNUCAManager,
+            "[SetConflict] Region %s %#x StartSet %d Conflicts %lu / %lu.\n",
+            region.name, region.vaddr, rangeMap.startSet, regionConflicts[i],
+            numSamples);
+    log << region.name << ' ' << std::hex << region.vaddr << std::dec
+        << " group " << std::hex << group.front() << std::dec << " startSet "
+        << rangeMap.startSet << " conflicts " << regionConflicts[i]
+        << " samples " << numSamples << " ratio " << conflictRatio << '\n';
+  }
+  log << std::flush;
+}
+
+std::ostream &StreamNUCAManager::getSetConflictLog() {
+  if (!this->setConflictLog) {
+    auto directory = simout.findOrCreateSubdirectory("stream_nuca");
+    this->setConflictLog = directory->create("set_conflict.txt");
   }
+  return *this->setConflictLog->stream();
 }
 
 StreamNUCAManager::StreamRegion &
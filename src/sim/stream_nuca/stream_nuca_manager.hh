@@ -4,13 +4,20 @@
 #include "sim/process.hh"
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 
+class OutputStream;
+
 class StreamNUCAManager {
 public:
   StreamNUCAManager(Process *_process, bool _enabled,
                     const std::string &_indirectPageRemapPolicy,
-                    float _indirectPageRemapThreshold);
+                    float _indirectPageRemapThreshold, int _remapThreads,
+                    bool _onlineMigrate, uint64_t _onlineMigrateInterval,
+                    int _onlineMigrateMaxPages,
+                    Tick _onlineMigrateCopyLatency,
+                    const std::string &_cacheSetPolicy);
 
   /**
    * We panic on copy. Required for process clone.
@@ -35,6 +42,14 @@ public:
   void defineAlign(Addr A, Addr B, int64_t elementOffset);
   void remap(ThreadContext *tc);
 
+  /**
+   * Save/restore the regions and the global StreamNUCAMap and
+   * NUMAPageAllocator. The remapped pages are in the page table, and
+   * the sampled online migration state starts again after restore.
+   */
+  void serialize(CheckpointOut &cp) const;
+  void unserialize(CheckpointIn &cp);
+
   struct StreamAlign {
     Addr vaddrA;
     Addr vaddrB;
@@ -60,6 +75,34 @@ public:
   const StreamRegion &getContainingStreamRegion(Addr vaddr) const;
   int getNumStreamRegions() const { return this->startVAddrRegionMap.size(); }
 
+  /**
+   * Online page migration. LLC stream engines sample the bank each indirect
+   * request goes to, keyed by the page of its base element in an indirect
+   * region. After every onlineMigrateInterval samples, the migration is
+   * pending and hot pages are migrated to the closest NUMA node by the next
+   * StreamConfig that finds the system quiesced (no LLC stream and no core
+   * memory access in flight). Streams configured later wait for the modeled
+   * copy.
+   */
+  bool isOnlineMigrationEnabled() const {
+    return this->enabled && this->onlineMigrate;
+  }
+  bool isOnlineMigrationPending() const {
+    return this->onlineMigratePending;
+  }
+  /**
+   * A pending migration is delayed as the system is not quiesced.
+   */
+  void sampleOnlineMigrationBlocked() { onlineMigrateBlockedAttempts++; }
+  void sampleIndirectAccess(Addr baseVAddr, int targetBank);
+  /**
+   * @return whether any page is migrated.
+   */
+  bool tryOnlineMigration(ThreadContext *tc);
+  bool isOnlineMigrationCopying() const {
+    return curTick() < this->onlineMigrateDoneTick;
+  }
+
 private:
   Process *process;
   const bool enabled;
@@ -68,7 +111,26 @@ private:
     TILE,
   };
   IndirectPageRemapPolicy indirectPageRemapPolicy;
+  /**
+   * How to assign the StartSet of aligned regions.
+   * FOOTPRINT: advance by the cached footprint of the previous region.
+   * STAGGER: partition the sets by the element size of aligned regions.
+   */
+  enum CacheSetPolicy {
+    FOOTPRINT,
+    STAGGER,
+  };
+  CacheSetPolicy cacheSetPolicy;
   const float indirectPageRemapThreshold;
+  /**
+   * Host threads to remap indirect region. 0 means all host cores.
+   */
+  const int remapThreads;
+  const bool onlineMigrate;
+  const uint64_t onlineMigrateInterval;
+  const int onlineMigrateMaxPages;
+  // Latency to copy one cache line of the migrated page.
+  const Tick onlineMigrateCopyLatency;
 
   std::map<Addr, StreamRegion> startVAddrRegionMap;
 
@@ -83,15 +145,57 @@ private:
   void remapDirectRegion(const StreamRegion &region);
   uint64_t determineInterleave(const StreamRegion &region);
 
+  /**
+   * Indirect region is remapped in batches of pages. The AlignToBank
+   * frequency of pages within a batch is computed in parallel.
+   */
+  static constexpr int RemapBatchPagesPerThread = 64;
+  struct IndirectPage {
+    Addr vaddr = 0;
+    Addr paddr = 0;
+    int64_t numBytes = 0;
+    char *data = nullptr;
+    std::vector<int32_t> alignToBankFrequency;
+    // Frequency per NUMA interleave chunk, NumChunks x NumBanks.
+    std::vector<int32_t> chunkAlignToBankFrequency;
+  };
+
   void remapIndirectRegion(ThreadContext *tc, const StreamRegion &region);
   void remapIndirectPage(ThreadContext *tc, const StreamRegion &region,
-                         const StreamRegion &alignToRegion, Addr pageVAddr);
-  int64_t computeHopsAndFreq(const StreamRegion &region,
-                             const StreamRegion &alignToRegion, Addr pageVAddr,
-                             int64_t numBytes, char *pageData,
-                             std::vector<int32_t> &alignToBankFrequency);
+                         const StreamRegion &alignToRegion,
+                         const IndirectPage &page);
+  void computeAlignToBankFreq(const StreamRegion &region,
+                              const StreamRegion &alignToRegion,
+                              const std::vector<Addr> &alignToPagePAddrs,
+                              IndirectPage &page);
+  int getRemapThreads() const;
+
+  /**
+   * Hops from each NUMA node to each bank, indexed by
+   * NUMANodeId * NumBanks + Bank.
+   */
+  std::vector<int64_t> numaBankHops;
+  uint64_t numaChunkBytes = 0;
+  int numaChunksPerPage = 0;
+  void initNUMABankHops();
+  int64_t computeHops(int numaNodeId, const int32_t *bankFrequency) const;
+  int64_t computePageHops(Addr pagePAddr, const IndirectPage &page) const;
+  int selectNUMANode(const std::vector<int32_t> &alignToBankFrequency,
+                     int &selectedBank) const;
+
+  /**
+   * Sampled pages for online migration.
+   */
+  std::unordered_map<Addr, IndirectPage> onlinePages;
+  uint64_t onlineSamples = 0;
+  bool onlineMigratePending = false;
+  Tick onlineMigrateDoneTick = 0;
+  const StreamRegion *findIndirectRegion(Addr vaddr) const;
 
   void computeCacheSet();
+  void computeSetConflict(const std::vector<Addr> &group);
+  OutputStream *setConflictLog = nullptr;
+  std::ostream &getSetConflictLog();
 
   /**
    * Stats.
@@ -109,6 +213,19 @@ private:
 
   static Stats::ScalarNoReset indRegionMemToLLCFinalHops;
   static Stats::DistributionNoReset indRegionMemFinalBanks;
+
+  static Stats::ScalarNoReset indRegionRemapWallTime;
+
+  static Stats::ScalarNoReset onlineMigrateEpochs;
+  static Stats::ScalarNoReset onlineMigrateBlockedAttempts;
+  static Stats::ScalarNoReset onlineMigrateSampledPages;
+  static Stats::ScalarNoReset onlineMigratePages;
+  static Stats::ScalarNoReset onlineMigrateDefaultHops;
+  static Stats::ScalarNoReset onlineMigrateRemappedHops;
+  static Stats::ScalarNoReset onlineMigrateCopyTicks;
+
+  static Stats::ScalarNoReset alignGroupSetSamples;
+  static Stats::ScalarNoReset alignGroupSetConflicts;
 };
 
 #endif
\ No newline at end of file
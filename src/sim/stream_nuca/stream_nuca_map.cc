@@ -4,6 +4,8 @@
 
 #include "debug/StreamNUCAMap.hh"
 
+#include <algorithm>
+
 bool StreamNUCAMap::topologyInitialized = false;
 int StreamNUCAMap::numRows = 0;
 int StreamNUCAMap::numCols = 0;
@@ -13,6 +15,15 @@ int StreamNUCAMap::cacheNumSet = 0;
 int StreamNUCAMap::cacheAssoc = 0;
 StreamNUCAMap::NonUniformNodeVec StreamNUCAMap::numaNodes;
 std::map<Addr, StreamNUCAMap::RangeMap> StreamNUCAMap::rangeMaps;
+constexpr int StreamNUCAMap::PageTableShift;
+constexpr int32_t StreamNUCAMap::PageTableNoRange;
+constexpr int32_t StreamNUCAMap::PageTableMultiRange;
+constexpr uint64_t StreamNUCAMap::PageTableMaxPages;
+bool StreamNUCAMap::pageTableEnabled = true;
+bool StreamNUCAMap::pageTableDirty = false;
+Addr StreamNUCAMap::pageTableBasePage = 0;
+std::vector<int32_t> StreamNUCAMap::pageTable;
+std::vector<StreamNUCAMap::RangeMap *> StreamNUCAMap::pageTableRanges;
 
 void StreamNUCAMap::initializeTopology(int numRows, int numCols) {
   if (topologyInitialized) {
@@ -110,6 +121,82 @@ void StreamNUCAMap::addRangeMap(Addr startPAddr, Addr endPAddr,
   rangeMaps.emplace(std::piecewise_construct, std::forward_as_tuple(startPAddr),
                     std::forward_as_tuple(startPAddr, endPAddr, interleave,
                                           startBank, startSet));
+  pageTableDirty = true;
+}
+
+void StreamNUCAMap::serialize(CheckpointOut &cp) {
+  ScopedCheckpointSection sec(cp, "streamNUCAMap");
+  paramOut(cp, "rangeMaps.size", rangeMaps.size());
+  size_t count = 0;
+  for (const auto &entry : rangeMaps) {
+    const auto &range = entry.second;
+    ScopedCheckpointSection rangeSec(cp, csprintf("Range%d", count++));
+    paramOut(cp, "startPAddr", range.startPAddr);
+    paramOut(cp, "endPAddr", range.endPAddr);
+    paramOut(cp, "interleave", range.interleave);
+    paramOut(cp, "startBank", range.startBank);
+    paramOut(cp, "startSet", range.startSet);
+  }
+}
+
+void StreamNUCAMap::unserialize(CheckpointIn &cp) {
+  ScopedCheckpointSection sec(cp, "streamNUCAMap");
+  // Every process sharing the map restores the same ranges.
+  rangeMaps.clear();
+  size_t numRanges;
+  paramIn(cp, "rangeMaps.size", numRanges);
+  for (size_t i = 0; i < numRanges; ++i) {
+    ScopedCheckpointSection rangeSec(cp, csprintf("Range%d", i));
+    Addr startPAddr;
+    Addr endPAddr;
+    uint64_t interleave;
+    int startBank;
+    int startSet;
+    UNSERIALIZE_SCALAR(startPAddr);
+    UNSERIALIZE_SCALAR(endPAddr);
+    UNSERIALIZE_SCALAR(interleave);
+    UNSERIALIZE_SCALAR(startBank);
+    UNSERIALIZE_SCALAR(startSet);
+    addRangeMap(startPAddr, endPAddr, interleave, startBank, startSet);
+  }
+  pageTableDirty = true;
+}
+
+void StreamNUCAMap::buildPageTable() {
+  pageTableDirty = false;
+  pageTable.clear();
+  pageTableRanges.clear();
+  if (rangeMaps.empty()) {
+    return;
+  }
+  auto basePage = rangeMaps.begin()->second.startPAddr >> PageTableShift;
+  Addr endPage = 0;
+  for (const auto &entry : rangeMaps) {
+    endPage = std::max(endPage,
+                       ((entry.second.endPAddr - 1) >> PageTableShift) + 1);
+  }
+  if (endPage - basePage > PageTableMaxPages) {
+    DPRINTF(StreamNUCAMap, "Skip PageTable for %lu pages.\n",
+            endPage - basePage);
+    return;
+  }
+  pageTableBasePage = basePage;
+  pageTable.assign(endPage - basePage, PageTableNoRange);
+  for (auto &entry : rangeMaps) {
+    auto &range = entry.second;
+    int32_t rangeIdx = pageTableRanges.size();
+    pageTableRanges.push_back(&range);
+    auto startPage = range.startPAddr >> PageTableShift;
+    auto lastPage = (range.endPAddr - 1) >> PageTableShift;
+    for (auto page = startPage; page <= lastPage; ++page) {
+      auto &pageEntry = pageTable[page - basePage];
+      // Pages shared by multiple ranges have to search rangeMaps.
+      pageEntry = (pageEntry == PageTableNoRange) ? rangeIdx
+                                                  : PageTableMultiRange;
+    }
+  }
+  DPRINTF(StreamNUCAMap, "Build PageTable for %lu pages %lu ranges.\n",
+          pageTable.size(), pageTableRanges.size());
 }
 
 StreamNUCAMap::RangeMap &
@@ -122,6 +209,35 @@ StreamNUCAMap::getRangeMapByStartPAddr(Addr startPAddr) {
 }
 
 StreamNUCAMap::RangeMap *StreamNUCAMap::getRangeMapContaining(Addr paddr) {
+  if (!pageTableEnabled) {
+    return searchRangeMapContaining(paddr);
+  }
+  if (pageTableDirty) {
+    buildPageTable();
+  }
+  if (pageTable.empty()) {
+    return rangeMaps.empty() ? nullptr : searchRangeMapContaining(paddr);
+  }
+  // The unsigned wrap around also covers pages below the base.
+  auto pageIdx = (paddr >> PageTableShift) - pageTableBasePage;
+  if (pageIdx >= pageTable.size()) {
+    return nullptr;
+  }
+  auto rangeIdx = pageTable[pageIdx];
+  if (rangeIdx == PageTableNoRange) {
+    return nullptr;
+  } else if (rangeIdx == PageTableMultiRange) {
+    return searchRangeMapContaining(paddr);
+  }
+  auto range = pageTableRanges[rangeIdx];
+  // The range may only cover part of the page.
+  if (paddr < range->startPAddr || paddr >= range->endPAddr) {
+    return nullptr;
+  }
+  return range;
+}
+
+StreamNUCAMap::RangeMap *StreamNUCAMap::searchRangeMapContaining(Addr paddr) {
   auto iter = rangeMaps.upper_bound(paddr);
   if (iter == rangeMaps.begin()) {
     return nullptr;
@@ -141,8 +257,14 @@ int StreamNUCAMap::getBank(Addr paddr) {
     auto endPAddr = range->endPAddr;
     auto startBank = range->startBank;
     auto diffPAddr = paddr - startPAddr;
-    auto bank = startBank + diffPAddr / interleave;
-    bank = bank % (getNumRows() * getNumCols());
+    auto numBanks = getNumRows() * getNumCols();
+    uint64_t bank;
+    if (range->interleaveShift >= 0 && isPowerOf2(numBanks)) {
+      bank = (startBank + (diffPAddr >> range->interleaveShift)) &
+             (numBanks - 1);
+    } else {
+      bank = (startBank + diffPAddr / interleave) % numBanks;
+    }
     DPRINTF(StreamNUCAMap,
             "Map PAddr %#x in [%#x, %#x) %% %lu + StartBank(%d) to Bank %d of "
             "%dx%d.\n",
@@ -160,17 +282,34 @@ int StreamNUCAMap::getSet(Addr paddr) {
     auto endPAddr = range->endPAddr;
     auto startSet = range->startSet;
     auto diffPAddr = paddr - startPAddr;
-    auto globalBankInterleave = interleave * getNumCols() * getNumRows();
-    /**
-     * Skip the line bits and bank bits.
-     */
-    auto localBankOffset = diffPAddr % interleave;
-    auto globalBankOffset = diffPAddr / globalBankInterleave;
+    auto numBanks = getNumCols() * getNumRows();
+    auto blockSize = getCacheBlockSize();
+    auto numSet = getCacheNumSet();
+    uint64_t finalSetNum;
+    auto blockShift = floorLog2(blockSize);
+    if (range->interleaveShift >= blockShift && isPowerOf2(numBanks) &&
+        isPowerOf2(blockSize) && isPowerOf2(numSet)) {
+      // Same as below with shifts and masks.
+      auto localBankOffset = diffPAddr & (interleave - 1);
+      auto globalBankOffset =
+          diffPAddr >> (range->interleaveShift + floorLog2(numBanks));
+      auto setNum =
+          (globalBankOffset << (range->interleaveShift - blockShift)) +
+          (localBankOffset >> blockShift);
+      finalSetNum = (setNum + startSet) & (numSet - 1);
+    } else {
+      auto globalBankInterleave = interleave * numBanks;
+      /**
+       * Skip the line bits and bank bits.
+       */
+      auto localBankOffset = diffPAddr % interleave;
+      auto globalBankOffset = diffPAddr / globalBankInterleave;
 
-    auto setNum = (globalBankOffset * (interleave / getCacheBlockSize())) +
-                  localBankOffset / getCacheBlockSize();
+      auto setNum = (globalBankOffset * (interleave / blockSize)) +
+                    localBankOffset / blockSize;
 
-    auto finalSetNum = (setNum + startSet) % getCacheNumSet();
+      finalSetNum = (setNum + startSet) % numSet;
+    }
 
     DPRINTF(StreamNUCAMap,
             "Map PAddr %#x in [%#x, %#x) %% %lu + StartSet(%d) "
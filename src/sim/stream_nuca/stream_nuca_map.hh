@@ -2,10 +2,13 @@
 #define __GEM_FORGE_STREAM_NUCA_MAP_HH__
 
 #include "base/addr_range.hh"
+#include "base/intmath.hh"
 #include "base/types.hh"
 #include "mem/ruby/common/MachineID.hh"
+#include "sim/serialize.hh"
 
 #include <map>
+#include <vector>
 
 /**
  * This is in charge of mapping physical addresses to some banks.
@@ -69,10 +72,16 @@ public:
     uint64_t interleave;
     int startBank;
     int startSet;
+    /**
+     * Log2 of the interleave, or -1 if it is not a power of two.
+     */
+    int interleaveShift;
     RangeMap(Addr _startPAddr, Addr _endPAddr, uint64_t _interleave,
              int _startBank, int _startSet)
         : startPAddr(_startPAddr), endPAddr(_endPAddr), interleave(_interleave),
-          startBank(_startBank), startSet(_startSet) {}
+          startBank(_startBank), startSet(_startSet),
+          interleaveShift(isPowerOf2(_interleave) ? floorLog2(_interleave)
+                                                  : -1) {}
   };
 
   static void addRangeMap(Addr startPAddr, Addr endPAddr, uint64_t interleave,
@@ -83,6 +92,31 @@ public:
   static int getBank(Addr paddr);
   static int getSet(Addr paddr);
 
+  /**
+   * Build the page table now if needed. After this, lookups are read only
+   * and can be done from multiple host threads.
+   */
+  static void buildLookupTable() {
+    if (pageTableEnabled && pageTableDirty) {
+      buildPageTable();
+    }
+  }
+
+  /**
+   * Lookup through the page table instead of searching rangeMaps.
+   * Enabled by default, can be disabled to compare the performance.
+   */
+  static void setPageTableEnabled(bool enabled) {
+    pageTableEnabled = enabled;
+  }
+
+  /**
+   * Save/restore the range maps. The topology, cache and NUMA nodes are
+   * rebuilt from the configuration, so they are not saved.
+   */
+  static void serialize(CheckpointOut &cp);
+  static void unserialize(CheckpointIn &cp);
+
 private:
   static bool topologyInitialized;
   static int numRows;
@@ -95,6 +129,25 @@ private:
   static NonUniformNodeVec numaNodes;
 
   static std::map<Addr, RangeMap> rangeMaps;
+
+  /**
+   * A flat table indexed by physical page number, so that mapping an
+   * address is a single load instead of searching rangeMaps. Each entry
+   * is an index into pageTableRanges, or one of the special values below.
+   * It is rebuilt lazily after addRangeMap. The RangeMap is referenced by
+   * pointer, so later changes to its startSet are still seen.
+   */
+  static constexpr int PageTableShift = 12;
+  static constexpr int32_t PageTableNoRange = -1;
+  static constexpr int32_t PageTableMultiRange = -2;
+  static constexpr uint64_t PageTableMaxPages = 64ull * 1024 * 1024;
+  static bool pageTableEnabled;
+  static bool pageTableDirty;
+  static Addr pageTableBasePage;
+  static std::vector<int32_t> pageTable;
+  static std::vector<RangeMap *> pageTableRanges;
+  static void buildPageTable();
+  static RangeMap *searchRangeMapContaining(Addr paddr);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,114 @@
+/**
+ * Measure the host time per flit of the Garnet flit allocation and
+ * flitBuffer, i.e. the pooled allocator and the FIFO ring fast path
+ * against plain new/delete and the binary heap.
+ */
+
+#include <chrono>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "mem/ruby/network/garnet2.0/flitBuffer.hh"
+
+namespace {
+
+const int numFlits = 64;
+const int numRounds = 100000;
+
+using Clock = std::chrono::steady_clock;
+
+double
+nsPerFlit(Clock::time_point start, Clock::time_point end, uint64_t flits)
+{
+    auto ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+    return static_cast<double>(ns.count()) / flits;
+}
+
+/**
+ * A flit without the pool, to compare against malloc.
+ */
+struct MallocFlit
+{
+    MallocFlit(int id, RouteInfo route, Cycles curTime)
+        : id(id), route(route), time(curTime) {}
+    int id;
+    RouteInfo route;
+    Cycles time;
+    MsgPtr msg;
+};
+
+void
+benchAlloc()
+{
+    RouteInfo route;
+    std::vector<flit *> flits(numFlits);
+    auto start = Clock::now();
+    for (int round = 0; round < numRounds; ++round) {
+        for (int i = 0; i < numFlits; ++i) {
+            flits[i] = new flit(i, 0, 0, route, numFlits, nullptr,
+                                Cycles(round));
+        }
+        for (int i = 0; i < numFlits; ++i) {
+            delete flits[i];
+        }
+    }
+    auto end = Clock::now();
+    cprintf("flit pool alloc/free:    %.2f ns/flit\n",
+            nsPerFlit(start, end, (uint64_t)numFlits * numRounds));
+
+    std::vector<MallocFlit *> mallocFlits(numFlits);
+    start = Clock::now();
+    for (int round = 0; round < numRounds; ++round) {
+        for (int i = 0; i < numFlits; ++i) {
+            mallocFlits[i] = new MallocFlit(i, route, Cycles(round));
+        }
+        for (int i = 0; i < numFlits; ++i) {
+            delete mallocFlits[i];
+        }
+    }
+    end = Clock::now();
+    cprintf("malloc alloc/free:       %.2f ns/flit\n",
+            nsPerFlit(start, end, (uint64_t)numFlits * numRounds));
+}
+
+void
+benchBuffer(bool inOrder)
+{
+    RouteInfo route;
+    std::vector<flit *> flits;
+    for (int i = 0; i < numFlits; ++i) {
+        // Reverse the time to force the heap path.
+        Cycles time(inOrder ? i : numFlits - i);
+        flits.push_back(new flit(i, 0, 0, route, numFlits, nullptr, time));
+    }
+    flitBuffer buffer;
+    uint64_t checksum = 0;
+    auto start = Clock::now();
+    for (int round = 0; round < numRounds; ++round) {
+        for (auto f : flits) {
+            buffer.insert(f);
+        }
+        while (!buffer.isEmpty()) {
+            checksum += buffer.getTopFlit()->get_id();
+        }
+    }
+    auto end = Clock::now();
+    cprintf("flitBuffer %s: %.2f ns/flit (checksum %llu)\n",
+            inOrder ? "in-order (ring)" : "out-of-order (heap)",
+            nsPerFlit(start, end, (uint64_t)numFlits * numRounds), checksum);
+    for (auto f : flits) {
+        delete f;
+    }
+}
+
+} // namespace
+
+int
+main()
+{
+    benchAlloc();
+    benchBuffer(true /* inOrder */);
+    benchBuffer(false /* inOrder */);
+    return 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * Measure the host time per lookup of StreamNUCAMap::getBank/getSet on
+ * a 64-bank (8x8) mesh, with the page table against searching the
+ * range maps.
+ */
+
+#include <chrono>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/random.hh"
+#include "sim/stream_nuca/stream_nuca_map.hh"
+
+namespace {
+
+const int numRanges = 256;
+const Addr rangeSize = 1024 * 1024;
+const int numAddrs = 4096;
+const int numRounds = 2000;
+
+using Clock = std::chrono::steady_clock;
+
+double
+nsPerLookup(Clock::time_point start, Clock::time_point end, uint64_t lookups)
+{
+    auto ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+    return static_cast<double>(ns.count()) / lookups;
+}
+
+void
+setupRanges()
+{
+    StreamNUCAMap::initializeTopology(8, 8);
+    StreamNUCAMap::initializeCache(64, 1024, 16);
+    for (int i = 0; i < numRanges; ++i) {
+        // Leave a page gap between ranges, and mix in some
+        // non-power-of-two interleaves.
+        Addr start = i * (rangeSize + 4096);
+        uint64_t interleave = (i % 4 == 3) ? 192 : (64 << (i % 4));
+        StreamNUCAMap::addRangeMap(start, start + rangeSize, interleave,
+                                   i % 64, i % 1024);
+    }
+}
+
+void
+bench(bool pageTable, const std::vector<Addr> &addrs)
+{
+    StreamNUCAMap::setPageTableEnabled(pageTable);
+    uint64_t checksum = 0;
+    auto start = Clock::now();
+    for (int round = 0; round < numRounds; ++round) {
+        for (auto paddr : addrs) {
+            checksum += StreamNUCAMap::getBank(paddr);
+            checksum += StreamNUCAMap::getSet(paddr);
+        }
+    }
+    auto end = Clock::now();
+    cprintf("StreamNUCAMap %s: %.2f ns/lookup (checksum %llu)\n",
+            pageTable ? "page table" : "range search",
+            nsPerLookup(start, end, (uint64_t)numAddrs * numRounds * 2),
+            checksum);
+}
+
+} // namespace
+
+int
+main()
+{
+    setupRanges();
+    std::vector<Addr> addrs;
+    Addr totalSize = numRanges * (rangeSize + 4096);
+    for (int i = 0; i < numAddrs; ++i) {
+        addrs.push_back(random_mt.random<Addr>(0, totalSize - 1));
+    }
+    bench(true /* pageTable */, addrs);
+    bench(false /* pageTable */, addrs);
+    return 0;
+}
@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+"""
+Simulator throughput benchmark for GemForge stream configurations.
+
+Runs the microkernels in kernels/ through configs/example/gem_forge/run.py
+for every combination of kernel, core count (4/16/64 cores on a mesh) and
+stream floating on/off, and records the host throughput (simulated kilo
+cycles per host second) and the peak host RSS of each run.
+
+The kernels need the GemForge stream compiler, which is not part of this
+tree. Build each kernels/<kernel>.c with it (linked with util/m5) and put
+the binary at <workloads>/<kernel>.exe.
+
+  bench.py --gem5 build/X86_MESI_Three_Level_Stream/gem5.opt \\
+      --workloads bench_bins --out results.json
+  bench.py ... --baseline base.json --tolerance 0.1
+
+With --baseline, a run whose throughput drops or whose peak RSS grows by
+more than the tolerance is reported as a regression and the script exits
+with 1.
+"""
+
+import argparse
+import json
+import math
+import os
+import re
+import subprocess
+import sys
+import time
+
+REPO = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+RUN_PY = os.path.join(REPO, 'configs', 'example', 'gem_forge', 'run.py')
+
+KERNELS = [
+    'affine_load',
+    'indirect_gather',
+    'reduction',
+    'atomic_update',
+    'pointer_chase',
+]
+
+FLOAT_FLAGS = [
+    '--gem-forge-stream-engine-enable-float',
+    '--gem-forge-stream-engine-enable-float-indirect',
+]
+
+
+class Config(object):
+
+    def __init__(self, kernel, cores, enable_float):
+        self.kernel = kernel
+        self.cores = cores
+        self.enable_float = enable_float
+
+    @property
+    def name(self):
+        return '{k}.c{c}.{f}'.format(
+            k=self.kernel, c=self.cores,
+            f='float' if self.enable_float else 'nofloat')
+
+    def gem5_args(self, args, out_dir):
+        rows = int(math.sqrt(self.cores))
+        assert(rows * rows == self.cores), 'Mesh needs square core count.'
+        exe = os.path.join(args.workloads, self.kernel + '.exe')
+        cmd = [
+            args.gem5,
+            '-d', out_dir,
+            RUN_PY,
+            '--cmd={exe}'.format(exe=exe),
+            '--options={t} {n}'.format(t=self.cores, n=args.elements),
+            '--num-cpus={c}'.format(c=self.cores),
+            '--cpu-type=DerivO3CPU',
+            '--ruby',
+            '--network=garnet2.0',
+            '--topology=MeshDirCorners_XY',
+            '--mesh-rows={r}'.format(r=rows),
+            '--num-dirs=4',
+            '--num-l2caches={c}'.format(c=self.cores),
+            '--l1d_size=32kB',
+            '--l2_size=256kB',
+            '--gem-forge-stream-engine-enable',
+        ]
+        if self.enable_float:
+            cmd += FLOAT_FLAGS
+        cmd += args.extra
+        return cmd
+
+
+def read_clock_period(out_dir):
+    # The cpu clock period in ticks from config.ini.
+    section = None
+    with open(os.path.join(out_dir, 'config.ini')) as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith('['):
+                section = line[1:-1]
+            elif section == 'system.cpu_clk_domain' and \
+                    line.startswith('clock='):
+                return int(line.split('=')[1].split()[0])
+    raise ValueError('No system.cpu_clk_domain in config.ini.')
+
+
+def read_final_tick(out_dir):
+    # final_tick is never reset, so the last dump covers the whole run.
+    final_tick = None
+    pattern = re.compile(r'^final_tick\s+(\d+)')
+    with open(os.path.join(out_dir, 'stats.txt')) as f:
+        for line in f:
+            match = pattern.match(line)
+            if match:
+                final_tick = int(match.group(1))
+    if final_tick is None:
+        raise ValueError('No final_tick in stats.txt.')
+    return final_tick
+
+
+def run(config, args):
+    out_dir = os.path.join(args.run_dir, config.name)
+    if not os.path.isdir(out_dir):
+        os.makedirs(out_dir)
+    cmd = config.gem5_args(args, out_dir)
+    with open(os.path.join(out_dir, 'command.txt'), 'w') as f:
+        f.write(' '.join(cmd) + '\n')
+    with open(os.path.join(out_dir, 'log.txt'), 'w') as log:
+        start = time.time()
+        process = subprocess.Popen(cmd, stdout=log, stderr=subprocess.STDOUT)
+        # wait4 to get the rusage of this child only.
+        _, status, rusage = os.wait4(process.pid, 0)
+        process.returncode = os.WEXITSTATUS(status) \
+            if os.WIFEXITED(status) else -1
+        host_seconds = time.time() - start
+
+    result = {
+        'kernel': config.kernel,
+        'cores': config.cores,
+        'float': config.enable_float,
+        'host_seconds': host_seconds,
+        # ru_maxrss is in KB on Linux.
+        'peak_rss_mb': rusage.ru_maxrss / 1024.0,
+        'ok': process.returncode == 0,
+    }
+    if result['ok']:
+        cycles = read_final_tick(out_dir) / read_clock_period(out_dir)
+        result['sim_cycles'] = cycles
+        result['kcycles_per_sec'] = cycles / 1e3 / host_seconds
+    return result
+
+
+def compare(results, baseline, tolerance):
+    base = dict(((r['kernel'], r['cores'], r['float']), r) for r in baseline)
+    regressions = list()
+    for r in results:
+        b = base.get((r['kernel'], r['cores'], r['float']))
+        if b is None or not b['ok']:
+            continue
+        name = Config(r['kernel'], r['cores'], r['float']).name
+        if not r['ok']:
+            regressions.append('{n}: failed'.format(n=name))
+            continue
+        if r['kcycles_per_sec'] < b['kcycles_per_sec'] * (1 - tolerance):
+            regressions.append('{n}: throughput {v:.1f} < {b:.1f}'.format(
+                n=name, v=r['kcycles_per_sec'], b=b['kcycles_per_sec']))
+        if r['peak_rss_mb'] > b['peak_rss_mb'] * (1 + tolerance):
+            regressions.append('{n}: peak rss {v:.1f}MB > {b:.1f}MB'.format(
+                n=name, v=r['peak_rss_mb'], b=b['peak_rss_mb']))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='GemForge simulator throughput benchmark.')
+    parser.add_argument('--gem5', required=True, help='the gem5 binary')
+    parser.add_argument('--workloads', required=True,
+                        help='directory of the compiled <kernel>.exe')
+    parser.add_argument('--run-dir', default='gem_forge_bench_runs',
+                        help='directory for the gem5 outputs')
+    parser.add_argument('--kernels', default=','.join(KERNELS))
+    parser.add_argument('--cores', default='4,16,64')
+    parser.add_argument('--float', choices=['both', 'on', 'off'],
+                        default='both')
+    parser.add_argument('--elements', type=int, default=65536,
+                        help='elements per kernel')
+    parser.add_argument('--extra', action='append', default=[],
+                        help='extra argument to run.py')
+    parser.add_argument('--out', default='gem_forge_bench.json')
+    parser.add_argument('--baseline', help='results to compare with')
+    parser.add_argument('--tolerance', type=float, default=0.1)
+    args = parser.parse_args()
+
+    floats = {'both': [False, True], 'on': [True], 'off': [False]}[args.float]
+    configs = [Config(k, int(c), f)
+               for k in args.kernels.split(',')
+               for c in args.cores.split(',')
+               for f in floats]
+
+    results = list()
+    print('{n:40} {t:>10} {k:>12} {m:>10}'.format(
+        n='config', t='host_s', k='kcycles/s', m='rss_mb'))
+    # Run sequentially so that runs don't disturb each other's throughput.
+    for config in configs:
+        r = run(config, args)
+        results.append(r)
+        print('{n:40} {t:10.1f} {k:>12} {m:10.1f}'.format(
+            n=config.name, t=r['host_seconds'],
+            k='{v:.1f}'.format(v=r['kcycles_per_sec']) if r['ok']
+            else 'failed',
+            m=r['peak_rss_mb']))
+        sys.stdout.flush()
+    with open(args.out, 'w') as f:
+        json.dump(results, f, indent=2)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            regressions = compare(results, json.load(f), args.tolerance)
+        for r in regressions:
+            print('REGRESSION ' + r)
+        if regressions:
+            sys.exit(1)
+    if not all(r['ok'] for r in results):
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
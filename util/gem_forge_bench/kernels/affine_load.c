@@ -0,0 +1,24 @@
+#include "common.h"
+
+/* Affine load: sum of a streaming array. */
+int main(int argc, char *argv[]) {
+  int threads;
+  int64_t n;
+  parse_args(argc, argv, &threads, &n);
+  Value *a = (Value *)aligned(n * sizeof(Value));
+  for (int64_t i = 0; i < n; ++i) {
+    a[i] = i;
+  }
+  warm_threads();
+
+  m5_detail_sim_start();
+  Value sum = 0;
+#pragma omp parallel for schedule(static) reduction(+ : sum)
+  for (int64_t i = 0; i < n; ++i) {
+    sum += a[i];
+  }
+  m5_detail_sim_end();
+
+  printf("%lld\n", (long long)sum);
+  return 0;
+}
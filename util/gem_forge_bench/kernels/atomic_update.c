@@ -0,0 +1,30 @@
+#include "common.h"
+
+/* Atomic update: histogram of random keys. */
+int main(int argc, char *argv[]) {
+  int threads;
+  int64_t n;
+  parse_args(argc, argv, &threads, &n);
+  const int64_t bins = n / 16 > 0 ? n / 16 : 1;
+  Value *hist = (Value *)aligned(bins * sizeof(Value));
+  int64_t *keys = (int64_t *)aligned(n * sizeof(int64_t));
+  uint64_t x = 1;
+  for (int64_t i = 0; i < n; ++i) {
+    x = next_random(x);
+    keys[i] = (x >> 16) % bins;
+  }
+  for (int64_t i = 0; i < bins; ++i) {
+    hist[i] = 0;
+  }
+  warm_threads();
+
+  m5_detail_sim_start();
+#pragma omp parallel for schedule(static)
+  for (int64_t i = 0; i < n; ++i) {
+    __atomic_fetch_add(&hist[keys[i]], 1, __ATOMIC_RELAXED);
+  }
+  m5_detail_sim_end();
+
+  printf("%lld\n", (long long)hist[0]);
+  return 0;
+}
@@ -0,0 +1,48 @@
+#ifndef __GEM_FORGE_BENCH_COMMON_H__
+#define __GEM_FORGE_BENCH_COMMON_H__
+
+/**
+ * Shared helpers of the simulator throughput microkernels. Each kernel
+ * takes "<threads> <elements>" as arguments, initializes its data outside
+ * the region of interest and wraps the kernel with the m5 detail markers.
+ */
+
+#include "gem5/m5ops.h"
+
+#include <omp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef int64_t Value;
+
+static inline void parse_args(int argc, char *argv[], int *threads,
+                              int64_t *elements) {
+  *threads = argc > 1 ? atoi(argv[1]) : 1;
+  *elements = argc > 2 ? atoll(argv[2]) : (1 << 16);
+  omp_set_num_threads(*threads);
+}
+
+/* Spin up the threads outside the region of interest. */
+static inline void warm_threads(void) {
+#pragma omp parallel
+  {
+    volatile int x = omp_get_thread_num();
+    (void)x;
+  }
+}
+
+static inline void *aligned(size_t bytes) {
+  void *p = NULL;
+  if (posix_memalign(&p, 64, bytes) != 0) {
+    abort();
+  }
+  return p;
+}
+
+/* Deterministic pseudo random indices. */
+static inline uint64_t next_random(uint64_t x) {
+  return x * 6364136223846793005ull + 1442695040888963407ull;
+}
+
+#endif
@@ -0,0 +1,28 @@
+#include "common.h"
+
+/* Indirect gather: b[i] = a[idx[i]]. */
+int main(int argc, char *argv[]) {
+  int threads;
+  int64_t n;
+  parse_args(argc, argv, &threads, &n);
+  Value *a = (Value *)aligned(n * sizeof(Value));
+  Value *b = (Value *)aligned(n * sizeof(Value));
+  int64_t *idx = (int64_t *)aligned(n * sizeof(int64_t));
+  uint64_t x = 1;
+  for (int64_t i = 0; i < n; ++i) {
+    a[i] = i;
+    x = next_random(x);
+    idx[i] = (x >> 16) % n;
+  }
+  warm_threads();
+
+  m5_detail_sim_start();
+#pragma omp parallel for schedule(static)
+  for (int64_t i = 0; i < n; ++i) {
+    b[i] = a[idx[i]];
+  }
+  m5_detail_sim_end();
+
+  printf("%lld\n", (long long)b[n - 1]);
+  return 0;
+}
@@ -0,0 +1,54 @@
+#include "common.h"
+
+/* Pointer chase: each thread walks its own random linked list. */
+typedef struct Node {
+  struct Node *next;
+  Value value;
+  Value padding[6];
+} Node;
+
+int main(int argc, char *argv[]) {
+  int threads;
+  int64_t n;
+  parse_args(argc, argv, &threads, &n);
+  Node *nodes = (Node *)aligned(n * sizeof(Node));
+  int64_t *order = (int64_t *)aligned(n * sizeof(int64_t));
+  for (int64_t i = 0; i < n; ++i) {
+    order[i] = i;
+    nodes[i].value = i;
+  }
+  /* Shuffle within each thread's chunk so the lists are disjoint. */
+  const int64_t chunk = (n + threads - 1) / threads;
+  uint64_t x = 1;
+  for (int64_t lhs = 0; lhs < n; lhs += chunk) {
+    int64_t rhs = lhs + chunk < n ? lhs + chunk : n;
+    for (int64_t i = rhs - 1; i > lhs; --i) {
+      x = next_random(x);
+      int64_t j = lhs + (x >> 16) % (i - lhs + 1);
+      int64_t tmp = order[i];
+      order[i] = order[j];
+      order[j] = tmp;
+    }
+    for (int64_t i = lhs; i < rhs; ++i) {
+      nodes[order[i]].next = i + 1 < rhs ? &nodes[order[i + 1]] : NULL;
+    }
+  }
+  warm_threads();
+
+  m5_detail_sim_start();
+  Value sum = 0;
+#pragma omp parallel for schedule(static, 1) reduction(+ : sum)
+  for (int t = 0; t < threads; ++t) {
+    int64_t lhs = t * chunk;
+    if (lhs >= n) {
+      continue;
+    }
+    for (Node *node = &nodes[order[lhs]]; node; node = node->next) {
+      sum += node->value;
+    }
+  }
+  m5_detail_sim_end();
+
+  printf("%lld\n", (long long)sum);
+  return 0;
+}
@@ -0,0 +1,181 @@
+#!/usr/bin/env python
+"""
+Reader for the columnar binary stats written by "--stats-file bin://...",
+see src/base/stats/binary.hh for the format.
+
+  binary_stats.py stats.bin                   # summary
+  binary_stats.py stats.bin --dump -1         # last dump, like stats.txt
+  binary_stats.py stats.bin --stat sim_insts  # one stat over time
+  binary_stats.py stats.bin --stat sim_insts --interval
+                                              # per-interval deltas
+  binary_stats.py stats.bin --csv out.csv     # all dumps as csv
+
+As a module:
+
+  stats = BinaryStats('stats.bin')
+  stats.columns, stats.ticks
+  stats.column('system.cpu.numCycles')
+  stats.intervals('system.cpu.numCycles')
+"""
+
+from __future__ import print_function
+
+import argparse
+import struct
+import zlib
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+MAGIC = b'GFSTATS\0'
+VERSION = 1
+RECORD_SCHEMA = ord('S')
+RECORD_ROW = ord('R')
+ROW_DELTA = 0x1
+ROW_COMPRESSED = 0x2
+
+
+class BinaryStats(object):
+
+    def __init__(self, fn):
+        self.columns = list()
+        self.ticks = list()
+        # Each row holds the raw 64-bit patterns of the doubles.
+        self._rows = list()
+        with open(fn, 'rb') as f:
+            # bytearray indexes as ints in both python 2 and 3.
+            self._parse(bytearray(f.read()))
+        self._index = dict((name, i) for i, name in enumerate(self.columns))
+
+    def _parse(self, data):
+        if data[:8] != MAGIC:
+            raise ValueError('Not a binary stats file.')
+        version, _ = struct.unpack_from('<II', data, 8)
+        if version != VERSION:
+            raise ValueError('Unsupported version {v}.'.format(v=version))
+        pos = 16
+        prev = None
+        while pos < len(data):
+            record = data[pos]
+            pos += 1
+            if record == RECORD_SCHEMA:
+                num_columns, = struct.unpack_from('<I', data, pos)
+                pos += 4
+                for _ in range(num_columns):
+                    length, = struct.unpack_from('<H', data, pos)
+                    pos += 2
+                    self.columns.append(data[pos:pos + length].decode())
+                    pos += length
+            elif record == RECORD_ROW:
+                flags = data[pos]
+                tick, raw_bytes, stored_bytes = \
+                    struct.unpack_from('<QII', data, pos + 1)
+                pos += 17
+                payload = data[pos:pos + stored_bytes]
+                pos += stored_bytes
+                if len(payload) != stored_bytes:
+                    # Truncated by a crashed simulation.
+                    break
+                if flags & ROW_COMPRESSED:
+                    payload = bytearray(zlib.decompress(bytes(payload)))
+                assert(len(payload) == raw_bytes)
+                row = self._decode(payload)
+                if flags & ROW_DELTA:
+                    assert(prev is not None)
+                    row = self._xor(prev, row)
+                self.ticks.append(tick)
+                self._rows.append(row)
+                prev = row
+            else:
+                raise ValueError('Unknown record {r} at {p}.'.format(
+                    r=record, p=pos - 1))
+
+    @staticmethod
+    def _decode(payload):
+        if numpy is not None:
+            return numpy.frombuffer(payload, dtype='<u8').copy()
+        # array has no 64-bit typecode in python 2, use struct instead.
+        return list(struct.unpack_from(
+            '<{n}Q'.format(n=len(payload) // 8), bytes(payload)))
+
+    @staticmethod
+    def _xor(prev, delta):
+        if numpy is not None:
+            return numpy.bitwise_xor(prev, delta)
+        return [a ^ b for a, b in zip(prev, delta)]
+
+    @staticmethod
+    def _to_doubles(row):
+        if numpy is not None:
+            return row.view('<f8')
+        return list(struct.unpack(
+            '<{n}d'.format(n=len(row)), struct.pack(
+                '<{n}Q'.format(n=len(row)), *row)))
+
+    def __len__(self):
+        return len(self._rows)
+
+    def row(self, i):
+        """
+        Values of the ith dump as a dict from stat name.
+        """
+        return dict(zip(self.columns, self._to_doubles(self._rows[i])))
+
+    def column(self, name):
+        """
+        Values of one stat in all dumps.
+        """
+        idx = self._index[name]
+        return [self._to_doubles(row)[idx] for row in self._rows]
+
+    def intervals(self, name):
+        """
+        Per-interval deltas of one stat. Only meaningful if the stats are not
+        reset between dumps, e.g. with periodic dumps.
+        """
+        values = self.column(name)
+        return [b - a for a, b in zip([0.0] + values[:-1], values)]
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Read GemForge binary stats.')
+    parser.add_argument('file')
+    parser.add_argument('--dump', type=int,
+                        help='print all stats of this dump')
+    parser.add_argument('--stat', action='append', default=[],
+                        help='print this stat over all dumps')
+    parser.add_argument('--interval', action='store_true',
+                        help='print per-interval deltas for --stat')
+    parser.add_argument('--csv', help='write all dumps to this csv file')
+    args = parser.parse_args()
+
+    stats = BinaryStats(args.file)
+    if args.dump is not None:
+        for name, value in zip(stats.columns,
+                               stats._to_doubles(stats._rows[args.dump])):
+            print('{n:60} {v}'.format(n=name, v=value))
+    elif args.stat:
+        series = [stats.intervals(s) if args.interval else stats.column(s)
+                  for s in args.stat]
+        print(' '.join(['tick'] + args.stat))
+        for i, tick in enumerate(stats.ticks):
+            print(' '.join([str(tick)] + [str(s[i]) for s in series]))
+    elif args.csv:
+        with open(args.csv, 'w') as f:
+            f.write(','.join(['tick'] + stats.columns) + '\n')
+            for tick, row in zip(stats.ticks, stats._rows):
+                f.write(','.join([str(tick)] +
+                                 [repr(v) for v in stats._to_doubles(row)]))
+                f.write('\n')
+    else:
+        print('{d} dumps, {c} stats, ticks {s} - {e}'.format(
+            d=len(stats), c=len(stats.columns),
+            s=stats.ticks[0] if stats.ticks else '-',
+            e=stats.ticks[-1] if stats.ticks else '-'))
+
+
+if __name__ == '__main__':
+    main()
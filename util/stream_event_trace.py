@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""
+Convert the binary stream event trace written with
+"--gem-forge-stream-engine-enable-event-trace" to Chrome trace format, see
+src/cpu/gem_forge/accelerator/stream/stream_event_tracer.hh for the format.
+
+  stream_event_trace.py m5out/stream_event_trace -o trace.json
+
+Open trace.json in chrome://tracing or Perfetto. Core events are grouped
+by core, MLC/LLC events by bank, with one row per stream. Element lifetime
+from CoreAlloc to CoreRelease is shown as a slice, the run ahead budget
+from CoreThrottle as a counter, others as instants.
+"""
+
+import argparse
+import collections
+import json
+import os
+import struct
+
+MAGIC = b'GFSEVT\0\0'
+VERSION = 1
+RECORD = struct.Struct('<QQQIhhB7x')
+
+EVENT_TYPES = [
+    'CoreConfig',
+    'CoreAlloc',
+    'CoreAddrReady',
+    'CoreIssue',
+    'CoreValueReady',
+    'CoreRelease',
+    'CoreEnd',
+    'MLCConfig',
+    'MLCReceive',
+    'MLCEnd',
+    'LLCConfig',
+    'LLCIssue',
+    'LLCMigrateOut',
+    'LLCMigrateIn',
+    'LLCEnd',
+    'CoreThrottle',
+]
+
+Event = collections.namedtuple(
+    'Event', ['tick', 'static_id', 'element_idx', 'instance_id', 'core_id',
+              'bank', 'type'])
+
+
+def read_events(directory):
+    with open(os.path.join(directory, 'events.bin'), 'rb') as f:
+        data = f.read()
+    if data[:8] != MAGIC:
+        raise ValueError('Not a stream event trace.')
+    version, record_size = struct.unpack_from('<II', data, 8)
+    if version != VERSION or record_size != RECORD.size:
+        raise ValueError('Unsupported version {v} or record size {s}.'.format(
+            v=version, s=record_size))
+    pos = 16
+    # Ignore a partial record from a crashed simulation.
+    end = pos + (len(data) - pos) // RECORD.size * RECORD.size
+    events = [Event(*RECORD.unpack_from(data, p))
+              for p in range(pos, end, RECORD.size)]
+    # Each thread flushes its own buffer, so sort by tick.
+    events.sort(key=lambda e: e.tick)
+    return events
+
+
+def read_names(directory):
+    names = dict()
+    fn = os.path.join(directory, 'streams.txt')
+    if not os.path.isfile(fn):
+        return names
+    with open(fn) as f:
+        for line in f:
+            fields = line.split(None, 2)
+            if len(fields) == 3:
+                names[(int(fields[0]), int(fields[1]))] = fields[2].strip()
+    return names
+
+
+def convert(events, names, tick_per_us):
+    trace = list()
+    pids = dict()
+    tids = dict()
+
+    def get_pid(event):
+        if event.bank < 0:
+            key = 'core {c}'.format(c=event.core_id)
+        elif EVENT_TYPES[event.type].startswith('MLC'):
+            key = 'mlc {b}'.format(b=event.bank)
+        else:
+            key = 'llc {b}'.format(b=event.bank)
+        if key not in pids:
+            pids[key] = len(pids)
+            trace.append({'ph': 'M', 'name': 'process_name',
+                          'pid': pids[key], 'args': {'name': key}})
+        return pids[key]
+
+    def get_stream_name(event):
+        name = names.get((event.core_id, event.static_id),
+                         str(event.static_id))
+        return 'c{c} {n}'.format(c=event.core_id, n=name)
+
+    def get_tid(pid, event):
+        key = (pid, event.core_id, event.static_id)
+        if key not in tids:
+            tids[key] = len(tids)
+            trace.append({'ph': 'M', 'name': 'thread_name', 'pid': pid,
+                          'tid': tids[key],
+                          'args': {'name': get_stream_name(event)}})
+        return tids[key]
+
+    alloc = dict()
+    for event in events:
+        name = EVENT_TYPES[event.type] if event.type < len(EVENT_TYPES) \
+            else str(event.type)
+        pid = get_pid(event)
+        tid = get_tid(pid, event)
+        ts = event.tick / tick_per_us
+        element = (event.core_id, event.static_id, event.instance_id,
+                   event.element_idx)
+        args = {'instance': event.instance_id, 'element': event.element_idx}
+        if name == 'CoreAlloc':
+            alloc[element] = event
+            continue
+        if name == 'CoreThrottle':
+            # The run ahead budget (MaxSize) over time.
+            trace.append({'ph': 'C', 'name': 'budget', 'pid': pid,
+                          'tid': tid, 'ts': ts,
+                          'args': {get_stream_name(event):
+                                   event.element_idx}})
+            continue
+        if name == 'CoreRelease' and element in alloc:
+            begin = alloc.pop(element)
+            trace.append({'ph': 'X', 'name': 'element', 'pid': pid,
+                          'tid': tid, 'ts': begin.tick / tick_per_us,
+                          'dur': (event.tick - begin.tick) / tick_per_us,
+                          'args': args})
+            continue
+        trace.append({'ph': 'i', 's': 't', 'name': name, 'pid': pid,
+                      'tid': tid, 'ts': ts, 'args': args})
+    # Elements never released, e.g. the stream ended.
+    for element, event in alloc.items():
+        pid = get_pid(event)
+        trace.append({'ph': 'i', 's': 't', 'name': 'CoreAlloc', 'pid': pid,
+                      'tid': get_tid(pid, event),
+                      'ts': event.tick / tick_per_us,
+                      'args': {'instance': event.instance_id,
+                               'element': event.element_idx}})
+    return trace
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Convert stream event trace to Chrome trace format.')
+    parser.add_argument('directory',
+                        help='the stream_event_trace output directory')
+    parser.add_argument('-o', '--output', default='stream_event_trace.json')
+    parser.add_argument('--tick-per-us', type=float, default=1e6,
+                        help='simulation ticks per microsecond')
+    parser.add_argument('--summary', action='store_true',
+                        help='only print the number of events per type')
+    args = parser.parse_args()
+
+    events = read_events(args.directory)
+    if args.summary:
+        counter = collections.Counter(EVENT_TYPES[e.type] for e in events)
+        for name in EVENT_TYPES:
+            print('{n:16} {c}'.format(n=name, c=counter[name]))
+        return
+    names = read_names(args.directory)
+    trace = convert(events, names, args.tick_per_us)
+    with open(args.output, 'w') as f:
+        json.dump({'traceEvents': trace, 'displayTimeUnit': 'ns'}, f)
+
+
+if __name__ == '__main__':
+    main()